@@ -21,14 +21,66 @@ type NPCName = NonEmptyTrimmedString
 
 type OutfitName = NonEmptyTrimmedString
 
-type npcFormID = Annotated[Dict[BSTFile, Dict[FormID, List[PresetName]]], Field(default={}, description="Here you can set which presets should be applied to specific NPCs by their FormID. The FormID is their unique identifier. Works with modded NPCs!")]
-type npc = Annotated[Dict[NPCName, List[PresetName]], Field(default={}, description="Same as npcFormID, but you use the NPC names instead of the FormID.")]
-type factionFemale = Annotated[Dict[EditorID, List[PresetName]], Field(default={}, description="Here you can set which presets to distribute by faction for female NPCs.")]
-type factionMale = Annotated[Dict[EditorID, List[PresetName]], Field(default={}, description="Same as factionFemale, but for male NPCs.")]
-type npcPluginFemale = Annotated[Dict[BSTFile, List[PresetName]], Field(default={}, description="Here you can set which presets should be applied to female NPCs from a specific plugin/mod.")]
-type npcPluginMale = Annotated[Dict[BSTFile, List[PresetName]], Field(default={}, description="Same as npcPluginFemale but for male NPCs.")]
-type raceFemale = Annotated[Dict[RaceName, List[PresetName]], Field(default={}, description="Here you can define which presets should be applied to females of certain races. Works with custom races too! ONLY put female body presets here!")]
-type raceMale = Annotated[Dict[RaceName, List[PresetName]], Field(default={}, description="Same as above, but for males. ONLY put male body presets here (if you don't have any, leave it empty)!")]
+type SliderName = NonEmptyTrimmedString
+
+
+class WeightedPreset(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    name: PresetName
+    weight: Annotated[float, Field(default=1.0, ge=0, description="How likely this preset is to be picked, relative to the other presets of the same entry. Plain preset names have a weight of 1.")]
+
+
+type PresetEntry = PresetName | WeightedPreset
+
+type RandomSliderEntry = RandomSliderRange | RandomSliderValue | RandomSliderChoice
+
+
+class RandomSliderRange(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    name: SliderName
+    min: float
+    max: float
+    chance: Annotated[float, Field(default=100, ge=0, le=100, multiple_of=1, description="Percent chance that the slider is set at all.")]
+
+
+class RandomSliderValue(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    name: SliderName
+    value: float
+    chance: Annotated[float, Field(default=100, ge=0, le=100, multiple_of=1, description="Percent chance that the slider is set at all.")]
+
+
+class RandomSliderOption(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    chance: Annotated[float, Field(default=100, ge=0, le=100, multiple_of=1, description="Percent chance of taking this option when none of the options before it was taken. Leave it out on the last option to always take it.")]
+    sliders: List[RandomSliderEntry]
+
+
+class RandomSliderChoice(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    oneOf: List[RandomSliderOption]
+
+
+class RandomSliderLists(BaseModel):
+    model_config = ConfigDict(extra='forbid', strict=True, regex_engine='python-re')
+
+    nipple: List[RandomSliderEntry] = None
+    genital: List[RandomSliderEntry] = None
+
+
+type npcFormID = Annotated[Dict[BSTFile, Dict[FormID, List[PresetEntry]]], Field(default={}, description="Here you can set which presets should be applied to specific NPCs by their FormID. The FormID is their unique identifier. Works with modded NPCs!")]
+type npc = Annotated[Dict[NPCName, List[PresetEntry]], Field(default={}, description="Same as npcFormID, but you use the NPC names instead of the FormID.")]
+type factionFemale = Annotated[Dict[EditorID, List[PresetEntry]], Field(default={}, description="Here you can set which presets to distribute by faction for female NPCs.")]
+type factionMale = Annotated[Dict[EditorID, List[PresetEntry]], Field(default={}, description="Same as factionFemale, but for male NPCs.")]
+type npcPluginFemale = Annotated[Dict[BSTFile, List[PresetEntry]], Field(default={}, description="Here you can set which presets should be applied to female NPCs from a specific plugin/mod.")]
+type npcPluginMale = Annotated[Dict[BSTFile, List[PresetEntry]], Field(default={}, description="Same as npcPluginFemale but for male NPCs.")]
+type raceFemale = Annotated[Dict[RaceName, List[PresetEntry]], Field(default={}, description="Here you can define which presets should be applied to females of certain races. Works with custom races too! ONLY put female body presets here!")]
+type raceMale = Annotated[Dict[RaceName, List[PresetEntry]], Field(default={}, description="Same as above, but for males. ONLY put male body presets here (if you don't have any, leave it empty)!")]
 type blacklistedNpcsFormID = Annotated[Dict[BSTFile, List[FormID]], Field(default={}, description="Set which NPCs by their FormID should be ignored by OBody. Works with modded NPCs. Useful if you want modded NPCs to have a custom body you want to handle separately.")]
 type blacklistedOutfitsFromORefitFormID = Annotated[Dict[BSTFile, List[FormID]], Field(default={}, description="Here you can write outfit FormIDs if you don't want ORefit to be applied to them. Further details and explanation is available further below.")]
 type outfitsForceRefitFormID = Annotated[Dict[BSTFile, List[FormID]], Field(default={}, description="Here you can write outfit FormIDs if you want to force ORefit to be applied to them, in case ORefit can't detect them. Further details and explanation is available further below. You will not need to write anything in this key 99% of the time.")]
@@ -42,6 +94,9 @@ type blacklistedPresetsFromRandomDistribution = Annotated[List[PresetName], Fiel
 type blacklistedOutfitsFromORefit = Annotated[List[OutfitName], Field(default=["LS Force Naked", "OBody Nude 32"], description="Same as blacklistedOutfitsFromORefitFormID, but you use outfit names instead of their FormID.")]
 type outfitsForceRefit = Annotated[List[OutfitName], Field(default=[], description="Same as outfitsForceRefitFormID, but you use outfit names instead of their FormID.")]
 type blacklistedPresetsShowInOBodyMenu = Annotated[bool, Field(default=True, description="Whether you want the blacklisted presets to show in the O menu or not.")]
+type deterministicDistribution = Annotated[bool, Field(default=False, description="Give every NPC the same preset and random sliders each time its body is generated, for example after ResetActorOBodyMorphs, instead of drawing new ones.")]
+type distributionSalt = Annotated[int, Field(default=0, ge=0, le=18446744073709551615, description="Mixed into the per-NPC seed when deterministicDistribution is on. Change it to get a different, but still reproducible, set of bodies.")]
+type randomSliders = Annotated[RandomSliderLists, Field(default={}, description="Replaces the random nipple and genital sliders OBody adds to female NPCs. Each list is run from top to bottom, a slider gets a random value between min and max, and oneOf takes the first of its options whose chance passes. Leave a list out to keep OBody's own.")]
 
 
 class OBodyConfigModel(BaseModel):
@@ -68,6 +123,9 @@ class OBodyConfigModel(BaseModel):
     outfitsForceRefit: outfitsForceRefit
     blacklistedPresetsFromRandomDistribution: blacklistedPresetsFromRandomDistribution
     blacklistedPresetsShowInOBodyMenu: blacklistedPresetsShowInOBodyMenu
+    deterministicDistribution: deterministicDistribution
+    distributionSalt: distributionSalt
+    randomSliders: randomSliders
 
 
 def main(using_rapidjson: bool):
@@ -75,6 +133,8 @@ def main(using_rapidjson: bool):
     test_examples: list[str] = [
         """{"npcFormID":{"Skyrim.esm":{"00013BA3":["Bardmaid"],"00013BA2":["Wench Preset","IA - Demonic","Tasty Temptress - BHUNP Preset (Nude)"]},"Immersive Wenches.esp":{"0403197F":["Petite Mommy"],"0400C3C0":["s4rMs' - Gaia"]}},"npc":{"Mjoll the Lioness":["Hardass Warrior"],"Haelga":["Petite Mommy","IA - Demonic","s4rMs' - Gaia"],"Temba Wide-Arm":["Tasty Temptress - BHUNP Preset (Nude)"]},"factionFemale":{"SolitudeBardsCollegeFaction":["Hardass Warrior","Fantasy Figure - Nude","Royal Battle Maiden - BHUNP"],"TownSolitudeFaction":["QC-The Everywoman"],"CollegeofWinterholdFaction":["Tasty Temptress - BHUNP Preset (Nude)"]},"factionMale":{"CompanionsCircle":["HIMBO Muscled"],"TownWhiterunFaction":["HIMBO Simple"]},"npcPluginFemale":{"Bijin_AIO_Merged.esp":["Hardass warrior","SilverR1baka"],"Skyrim.esm":["Nordic Oppai - BHUNP - Nude"]},"npcPluginMale":{"Dawnguard.esm":["HIMBO Simple"]},"raceFemale":{"NordRace":["QC-The Everywoman","D*sney Mommy NG","Fantasy Figure - Nude"],"OrcRace":["Hardass warrior"],"WoodElfRace":["-Zeroed Sliders-"]},"raceMale":{"NordRace":["HIMBO Simple"],"BretonRace":["HIMBO Simple"]},"blacklistedNpcs":["Saffir","Vilja","Lydia"],"blacklistedNpcsFormID":{"Skyrim.esm":["00013BB8","00013BBD"],"CS_Vayne.esp":["0400083D","0402CC59"]},"blacklistedNpcsPluginFemale":["CS_Coralyn.esp","3DNPC.esp","Hearthfires.esm"],"blacklistedNpcsPluginMale":["Immersive Wenches.esp","018Auri.esp"],"blacklistedRacesFemale":["ElderRace","ArgonianRace"],"blacklistedRacesMale":["ElderRace","DarkElfRace"],"blacklistedOutfitsFromORefitFormID":{"[full_inu] Queen Marika's Dress.esp":["FE000817"]},"blacklistedOutfitsFromORefit":["Demon Hunter's Clothes Light","White Sexy Top Ouvert","Wrap Around Dress (Slutty) - 14"],"blacklistedOutfitsFromORefitPlugin":["[COCO] Mysterious Mage.esp"],"outfitsForceRefitFormID":{"[full_inu] Queen Marika's Dress.esp":["FE000803"]},"outfitsForceRefit":["Demon Hunter's Lingerie Light","Demon Hunter's Lingerie Heavy"],"blacklistedPresetsFromRandomDistribution":["- Zeroed Sliders -","-Zeroed Sliders-","Zeroed Sliders","s4mRs'' - Juno","Royal Battlemaiden - BHUNP"],"blacklistedPresetsShowInOBodyMenu":true}""",
         """{"npcFormID":{},"npc":{},"factionFemale":{},"factionMale":{},"npcPluginFemale":{},"npcPluginMale":{},"raceFemale":{},"raceMale":{},"blacklistedNpcs":[],"blacklistedNpcsFormID":{},"blacklistedNpcsPluginFemale":[],"blacklistedNpcsPluginMale":[],"blacklistedRacesFemale":["ElderRace"],"blacklistedRacesMale":["ElderRace"],"blacklistedOutfitsFromORefitFormID":{},"blacklistedOutfitsFromORefit":["LS Force Naked","OBody Nude 32"],"blacklistedOutfitsFromORefitPlugin":[],"outfitsForceRefitFormID":{},"outfitsForceRefit":[],"blacklistedPresetsFromRandomDistribution":["- Zeroed Sliders -","-Zeroed Sliders-","Zeroed Sliders","HIMBO Zero for OBody"],"blacklistedPresetsShowInOBodyMenu":true}""",
+        """{"npc":{"Haelga":[{"name":"Petite Mommy","weight":3},"IA - Demonic",{"name":"s4rMs' - Gaia","weight":0.5}]},"raceFemale":{"NordRace":[{"name":"QC-The Everywoman"},"Fantasy Figure - Nude"]}}""",
+        """{"randomSliders":{"nipple":[{"name":"NippleSize","min":-0.5,"max":0.3},{"oneOf":[{"chance":2,"sliders":[{"name":"NippleInvert_v2","value":1.0}]}]}]}}""",
     ]
     base_dir = Path(__file__).parent.parent.resolve()
     try:
@@ -1,5 +1,6 @@
 #include "Body/Body.h"
 
+#include "Body/MorphScheduler.h"
 #include "JSONParser/JSONParser.h"
 #include "STL.h"
 
@@ -8,6 +9,41 @@ using namespace PresetManager;
 Body::OBody Body::OBody::instance_;
 
 namespace Body {
+    namespace {
+        // Morphs whose OBody value ORefit slider derivation needs. Every MorphTransaction watches them, so their values
+        // land in a dense array indexed by DerivedMorph during its VisitMorphValues pass and stay there as presets set
+        // them, and derivation reads them with GetWatched instead of looking each one up by name.
+        enum DerivedMorph : std::uint8_t {
+            kBreastSideShape,
+            kBreastUnderDepth,
+            kBreastCleavage,
+            kButtDimples,
+            kButtUnderFold,
+            kClavicle,
+            kNavelEven,
+            kHipCarved,
+            kNippleDip,
+            kNippleTip,
+            kNipplePuffy,
+            kAreolaSize,
+            kNipBGone,
+            kNipplePerkManga,
+            kDerivedMorphCount
+        };
+
+        constexpr std::array<const char*, kDerivedMorphCount> DerivedMorphNames{
+            "BreastSideShape", "BreastUnderDepth", "BreastCleavage", "ButtDimples", "ButtUnderFold",
+            "Clavicle_v2",     "NavelEven",        "HipCarved",      "NippleDip",   "NippleTip",
+            "NipplePuffy_v2",  "AreolaSize",       "NipBGone",       "NipplePerkManga"};
+
+        // Keys OBody writes its morphs under: the body itself and ORefit. The derived morphs are under the first.
+        constexpr std::array<std::string_view, 2> MorphKeys{"OBody"sv, "OClothe"sv};
+
+        MorphTransaction BeginMorphs(SKEE::IBodyMorphInterface* a_interface, RE::Actor* a_actor) {
+            return {a_interface, a_actor, MorphKeys, DerivedMorphNames};
+        }
+    }  // namespace
+
     OBody& OBody::GetInstance() { return instance_; }
 
     bool OBody::SetMorphInterface(SKEE::IBodyMorphInterface* a_morphInterface) {
@@ -18,10 +54,6 @@ namespace Body {
         morphInterface->SetMorph(a_actor, a_morphName, a_key, a_value);
     }
 
-    float OBody::GetMorph(RE::Actor* a_actor, const char* a_morphName) const {
-        return morphInterface->GetMorph(a_actor, a_morphName, "OBody");
-    }
-
     void OBody::ApplyMorphs(RE::Actor* a_actor, const bool updateMorphsWithoutTimer,
                             const bool applyProcessedMorph) const {
         // If updateMorphsWithoutTimer is true, OBody NG will call the ApplyBodyMorphs function without waiting a random
@@ -31,6 +63,9 @@ namespace Body {
         RE::ActorHandle actorHandle{a_actor->GetHandle()};
 
         if (updateMorphsWithoutTimer || !setPerformanceMode) {
+            // Applied right now, so a delayed update still pending for the actor has nothing left to do
+            MorphScheduler::GetInstance().Cancel(actorHandle);
+
             if (RE::Actor* actor = actorHandle.get().get()) {
                 if (applyProcessedMorph) {
                     SetMorph(actor, distributionKey.c_str(), "OBody", 1.0F);
@@ -43,38 +78,20 @@ namespace Body {
                 }
             }
         } else {
-            // ReSharper disable CppDFAUnreadVariable
-            // ReSharper disable CppDFAUnusedValue
-            auto actorName{a_actor->GetActorBase()->GetName()};
-
-            const unsigned long seed{
-                static_cast<unsigned long>(std::chrono::system_clock::now().time_since_epoch().count())};
-            std::mt19937 rng{seed};
-            std::uniform_int_distribution gen{3, 7};
-
-            auto sleepFor{gen(rng)};
-            // ReSharper restore CppDFAUnusedValue
-            // ReSharper restore CppDFAUnreadVariable
-
             // We do this to prevent stutters due to Racemenu attempting to update morphs for too many NPCs
-            std::thread([this, actorHandle, actorName, sleepFor] {
-                std::this_thread::sleep_for(std::chrono::seconds(sleepFor));
-
-                if (RE::Actor * actor{actorHandle.get().get()}) {
-                    logger::info("Actor {} is valid, updating morphs now", actorName);
+            const std::chrono::seconds delay{stl::random(3, 8)};
+            MorphScheduler::GetInstance().Schedule(actorHandle, delay, [this, applyProcessedMorph](RE::Actor* actor) {
+                logger::info("Actor {} is valid, updating morphs now", actor->GetName());
 
+                if (applyProcessedMorph) {
                     SetMorph(actor, distributionKey.c_str(), "OBody", 1.0F);
+                }
 
-                    // ReSharper disable once CppDFAConstantConditions
-                    if (actor && actor->Is3DLoaded() &&
-                        !morphInterface->HasBodyMorph(actor, "obody_synthebd", "OBody")) {
-                        morphInterface->ApplyBodyMorphs(actor, true);
-                        morphInterface->UpdateModelWeight(actor, false);
-                    }
-                } else {
-                    logger::info("Actor {} is no longer valid, not updating morphs", actorName);
+                if (actor->Is3DLoaded() && !morphInterface->HasBodyMorph(actor, "obody_synthebd", "OBody")) {
+                    morphInterface->ApplyBodyMorphs(actor, true);
+                    morphInterface->UpdateModelWeight(actor, false);
                 }
-            }).detach();
+            });
         }
     }
 
@@ -89,14 +106,13 @@ namespace Body {
         // if ORefit is disabled and actor has ORefit morphs, clear them right away.
         if (!setRefit && IsClotheActive(a_actor)) {
             RemoveClothePreset(a_actor);
-            ApplyMorphs(a_actor, true);
+            ApplyMorphs(a_actor, true, false);
             return;
         }
 
         const bool female = IsFemale(a_actor);
 
-        if (const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-            (female && presetContainer.femalePresets.empty()) || !female && presetContainer.malePresets.empty()) {
+        if (PresetManager::PresetContainer::GetInstance().Get()->GetPresets(female).empty()) {
             return;
         }
 
@@ -111,11 +127,10 @@ namespace Body {
         if (clotheActive && naked) {
             logger::info("Removing clothed preset to actor {}", a_actor->GetName());
             RemoveClothePreset(a_actor);
-            ApplyMorphs(a_actor, true);
+            ApplyMorphs(a_actor, true, false);
         } else if (!clotheActive && !naked && setRefit) {
             logger::info("Applying clothed preset to actor {}", a_actor->GetName());
-            ApplyClothePreset(a_actor);
-            ApplyMorphs(a_actor, true);
+            if (ApplyClothePreset(a_actor)) ApplyMorphs(a_actor, true, false);
         }
     }
 
@@ -129,102 +144,88 @@ namespace Body {
 
         bool female{IsFemale(a_actor)};
 
-        auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        // Held until the body is generated, so a preset reload can't free the presets picked below
+        const auto presets{PresetManager::PresetContainer::GetInstance().Get()};
 
         // If we have no presets at all for the actor's sex, then don't do anything
-        if ((female && presetContainer.femalePresets.empty()) || !female && presetContainer.malePresets.empty()) {
+        if (presets->GetPresets(female).empty()) {
             return;
         }
 
-        auto& jsonParser{Parser::JSONParser::GetInstance()};
+        const auto* const name{a_actor->GetActorBase()->GetName()};
 
-        auto actorBase{a_actor->GetActorBase()};
-        auto actorName{actorBase->GetName()};
-        auto actorID{actorBase->GetFormID()};
+        logger::info("Trying to find and apply preset to {}", name);
+
+        const auto& parser{Parser::JSONParser::GetInstance()};
+
+        // Deterministic distribution seeds every draw below from the actor, so it gets the same preset and random
+        // sliders again after its morphs are reset
+        std::optional<stl::deterministic_random> seed;
+        if (parser.deterministicDistribution) {
+            seed.emplace(parser.GetDistributionSeed(a_actor));
+        }
 
-        logger::info("Trying to find and apply preset to {}", actorName);
+        const auto decision{parser.Resolve(a_actor, female, *presets)};
 
         // If NPC is blacklisted, set him as processed
-        if (jsonParser.IsNPCBlacklisted(actorName, actorID)) {
+        if (decision.source == Parser::RuleSource::kBlacklisted) {
             SetMorph(a_actor, distributionKey.c_str(), "OBody", 1.0F);
             SetMorph(a_actor, "obody_blacklisted", "OBody", 1.0F);
             return;
         }
 
-        // First, we attempt to get the NPC's preset from the keys npcFormID and npc from the JSON
-        std::optional<Preset> preset{jsonParser.GetNPCPreset(actorName, actorID, female)};
+        const auto* const preset{decision.preset};
 
-        if (!preset.has_value()) {
-            auto actorRace{stl::get_editorID(actorBase->GetRace()->As<RE::TESForm>())};
-
-            // if we can't find it, we check if the NPC is blacklisted by plugin name or by race
-            if (jsonParser.IsNPCBlacklistedGlobally(a_actor, actorRace.c_str(), female)) {
-                SetMorph(a_actor, distributionKey.c_str(), "OBody", 1.0F);
-                SetMorph(a_actor, "obody_blacklisted", "OBody", 1.0F);
-                return;
-            }
-
-            // Next up, we check if we have a preset defined in one of the NPC's factions
-            preset = jsonParser.GetNPCFactionPreset(actorBase, female);
-
-            // If that also fails, we check if we have a preset in the NPC's plugin
-            if (!preset.has_value()) {
-                preset = jsonParser.GetNPCPluginPreset(actorBase, actorName, female);
-            }
-
-            // And if that also fails, we check if we have a preset in the NPC's race
-            if (!preset.has_value()) {
-                preset = jsonParser.GetNPCRacePreset(actorRace.c_str(), female);
-            }
-        }
-
-        // If we got here without a preset, then we just fetch one randomly
-        if (!preset.has_value()) {
-            logger::info("No preset defined for this actor, getting it randomly");
-            preset =
-                PresetManager::GetRandomPreset(female ? presetContainer.femalePresets : presetContainer.malePresets);
-        }
-
-        logger::info("Preset {} will be applied to {}", preset->name, actorName);
+        logger::info("Preset {} will be applied to {}", preset->name, name);
 
         GenerateBodyByPreset(a_actor, *preset, false);
     }
 
     void OBody::GenerateBodyByName(RE::Actor* a_actor, const std::string& a_name) const {
-        const auto& presetContainer{PresetContainer::GetInstance()};
+        const auto presets{PresetContainer::GetInstance().Get()};
 
         // This is needed to prevent a crash with SynthEBD/Synthesis
         if (synthesisInstalled && a_actor != nullptr) {
             SetMorph(a_actor, "obody_synthebd", "OBody", 1.0F);
         }
 
-        Preset preset{GetPresetByName(
-            IsFemale(a_actor) ? presetContainer.allFemalePresets : presetContainer.allMalePresets, a_name, true)};
+        const auto* const preset{
+            GetPresetByName(presets->GetAllPresets(IsFemale(a_actor)), a_name, presets->GetPresets(true))};
 
-        GenerateBodyByPreset(a_actor, preset, true);
+        if (!preset) {
+            logger::info("No presets loaded, can't apply {} to {}", a_name, a_actor->GetName());
+            return;
+        }
+
+        GenerateBodyByPreset(a_actor, *preset, true);
     }
 
-    void OBody::GenerateBodyByPreset(RE::Actor* a_actor, PresetManager::Preset& a_preset,
+    void OBody::GenerateBodyByPreset(RE::Actor* a_actor, const PresetManager::Preset& a_preset,
                                      const bool updateMorphsWithoutTimer) const {
+        auto morphs{BeginMorphs(morphInterface, a_actor)};
+
         // Start by clearing any previous OBody morphs
-        morphInterface->ClearMorphs(a_actor);
+        morphs.ClearAll();
 
         // Apply the preset's sliders
-        ApplySliderSet(a_actor, a_preset.sliders, "OBody");
+        ApplySliderSet(morphs, a_preset.sliders, "OBody");
 
         logger::info("Applying preset: {}", a_preset.name);
 
         if (IsFemale(a_actor)) {
+            const auto& parser{Parser::JSONParser::GetInstance()};
+            PresetManager::RandomSliders sliders;
+
             // Generate random nipple sliders if needed
             if (setNippleRand) {
-                PresetManager::SliderSet set{GenerateRandomNippleSliders()};
-                ApplySliderSet(a_actor, set, "OBody");
+                parser.randomNippleSliders.Generate(sliders);
+                ApplyRandomSliders(morphs, sliders, "OBody");
             }
 
             if (setGenitalRand) {
                 // Generate random genital sliders if needed
-                PresetManager::SliderSet set{GenerateRandomGenitalSliders()};
-                ApplySliderSet(a_actor, set, "OBody");
+                parser.randomGenitalSliders.Generate(sliders);
+                ApplyRandomSliders(morphs, sliders, "OBody");
             }
         }
 
@@ -232,31 +233,54 @@ namespace Body {
         if (!IsNaked(a_actor, false, nullptr)) {
             if (setRefit) {
                 logger::info("Not naked, adding cloth preset");
-                ApplyClothePreset(a_actor);
+                ApplyClothePreset(morphs);
             }
         } else {
             logger::info("Actor is naked, not applying cloth preset");
             OnActorNaked.SendEvent(a_actor);
         }
 
-        ApplyMorphs(a_actor, updateMorphsWithoutTimer);
+        // Marked as processed in the same transaction, so reapplying an identical body changes nothing at all
+        morphs.Set(distributionKey, "OBody", 1.0F);
+        if (morphs.Commit()) {
+            ApplyMorphs(a_actor, updateMorphsWithoutTimer, false);
+        } else {
+            logger::info("Morphs of {} are unchanged, not updating the body", a_actor->GetName());
+        }
+
         OnActorGenerated.SendEvent(a_actor, a_preset.name);
     }
 
-    void OBody::ApplySlider(RE::Actor* a_actor, const PresetManager::Slider& a_slider, const char* a_key,
-                            const float a_weight) const {
+    void OBody::ApplySlider(MorphTransaction& a_morphs, const PresetManager::Slider& a_slider, const char* a_key,
+                            const float a_weight) {
         const float val{((a_slider.max - a_slider.min) * a_weight) + a_slider.min};
-        morphInterface->SetMorph(a_actor, a_slider.name.c_str(), a_key, val);
+        a_morphs.Set(a_slider.name(), a_key, val);
+    }
+
+    void OBody::ApplySliderSet(MorphTransaction& a_morphs, const PresetManager::SliderSet& a_sliders,
+                               const char* a_key) {
+        const float weight{GetWeight(a_morphs.GetActor())};
+        for (std::size_t i{}; i < a_sliders.size(); ++i) ApplySlider(a_morphs, a_sliders[i], a_key, weight);
     }
 
-    void OBody::ApplySliderSet(RE::Actor* a_actor, PresetManager::SliderSet& a_sliders, const char* a_key) const {
-        const float weight{GetWeight(a_actor)};
-        for (const auto& slider : a_sliders | std::views::values) ApplySlider(a_actor, slider, a_key, weight);
+    void OBody::ApplyRandomSliders(MorphTransaction& a_morphs, const PresetManager::RandomSliders& a_sliders,
+                                   const char* a_key) {
+        const auto& names{SliderNames::GetInstance()};
+        for (std::size_t i{}; i < a_sliders.size(); ++i) {
+            a_morphs.Set(names.GetName(a_sliders.ids[i]), a_key, a_sliders.values[i]);
+        }
+    }
+
+    bool OBody::ApplyClothePreset(RE::Actor* a_actor) const {
+        auto morphs{BeginMorphs(morphInterface, a_actor)};
+        ApplyClothePreset(morphs);
+        return morphs.Commit();
     }
 
-    void OBody::ApplyClothePreset(RE::Actor* a_actor) const {
-        auto set{GenerateClotheSliders(a_actor)};
-        ApplySliderSet(a_actor, set, "OClothe");
+    void OBody::ApplyClothePreset(MorphTransaction& a_morphs) const {
+        // Replaces every ORefit morph, so sliders that were turned off since the last refit don't linger
+        a_morphs.ClearKey("OClothe");
+        ApplySliderSet(a_morphs, GenerateClotheSliders(a_morphs), "OClothe");
     }
 
     void OBody::ClearActorMorphs(RE::Actor* a_actor) const {
@@ -346,140 +370,20 @@ namespace Body {
         return morphInterface->HasBodyMorph(a_actor, "obody_blacklisted", "OBody");
     }
 
-    PresetManager::SliderSet OBody::GenerateRandomNippleSliders() {
-        PresetManager::SliderSet set;
-
-        if (stl::chance(15))
-            AddSliderToSet(set, Slider{"AreolaSize", stl::random(-1.0f, 0.0f)});
-        else
-            AddSliderToSet(set, Slider{"AreolaSize", stl::random(0.0f, 1.0f)});
+    PresetManager::SliderSet OBody::GenerateClotheSliders(const MorphTransaction& a_morphs) const {
+        // Slider that takes the morph from its OBody value to a_target
+        const auto derive{[&a_morphs](const DerivedMorph a_morph, const float a_target) {
+            return Slider{DerivedMorphNames[a_morph], a_target - a_morphs.GetWatched(a_morph)};
+        }};
 
-        if (stl::chance(75)) AddSliderToSet(set, Slider{"AreolaPull_v2", stl::random(-0.25f, 1.0f)});
-
-        if (stl::chance(15))
-            AddSliderToSet(set, Slider{"NippleLength", stl::random(0.2f, 0.3f)});
-        else
-            AddSliderToSet(set, Slider{"NippleLength", stl::random(0.0f, 0.1f)});
-
-        AddSliderToSet(set, Slider{"NippleManga", stl::random(-0.3f, 0.8f)});
-
-        if (stl::chance(25)) AddSliderToSet(set, Slider{"NipplePerkManga", stl::random(-0.3f, 1.2f)});
-
-        if (stl::chance(15)) AddSliderToSet(set, Slider{"NipBGone", stl::random(0.6f, 1.0f)});
-
-        AddSliderToSet(set, Slider{"NippleSize", stl::random(-0.5f, 0.3f)});
-        AddSliderToSet(set, Slider{"NippleDip", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"NippleCrease_v2", stl::random(-0.4f, 1.0f)});
-
-        if (stl::chance(6)) AddSliderToSet(set, Slider{"NipplePuffy_v2", stl::random(0.4f, 0.7f)});
-
-        if (stl::chance(35)) AddSliderToSet(set, Slider{"NippleThicc_v2", stl::random(0.0f, 0.9f)});
-
-        if (stl::chance(2)) {
-            if (stl::chance(50))
-                AddSliderToSet(set, Slider{"NippleInvert_v2", 1.0f});
-            else
-                AddSliderToSet(set, Slider{"NippleInvert_v2", stl::random(0.65f, 0.8f)});
-        }
-
-        return set;
-    }
-
-    PresetManager::SliderSet OBody::GenerateRandomGenitalSliders() {
-        PresetManager::SliderSet set;
-
-        if (stl::chance(20)) {
-            // innie
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(0.95f, 1.1f)});
-
-            if (stl::chance(50)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.75f, 1.25f)});
-
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 1.0f)});
-
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 0.5f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 0.1f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 0.1f)});
-            AddSliderToSet(set, Slider{"Labiaspread", 0.0F});
-            AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.3f)});
-            AddSliderToSet(set, Slider{"LabiaBulgogi_v2", 0.0F});
-            AddSliderToSet(set, Slider{"LabiaNeat_v2", 0.0F});
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(-0.2f, 0.05f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.4f, 0.25f)});
-        } else if (stl::chance(75)) {
-            // average
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(0.4f, 0.75f)});
-
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.5f, 1.0f)});
-
-            if (stl::chance(30)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 0.75f)});
-
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 0.5f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 0.75f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 1.0f)});
-
-            if (stl::chance(50)) {
-                AddSliderToSet(set, Slider{"Labiaspread", stl::random(0.0f, 1.0f)});
-                AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.7f)});
-
-                if (stl::chance(60)) AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 0.1f)});
-            } else {
-                AddSliderToSet(set, Slider{"Labiaspread", 0.0F});
-                AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 0.2f)});
-
-                if (stl::chance(45)) AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 0.3f)});
-            }
-
-            AddSliderToSet(set, Slider{"LabiaNeat_v2", 0.0F});
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(-0.2f, 0.40f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.2f, 0.25f)});
-        } else {
-            // outie
-            AddSliderToSet(set, Slider{"Innieoutie", stl::random(-0.25f, 0.30f)});
-
-            if (stl::chance(30)) AddSliderToSet(set, Slider{"Labiapuffyness", stl::random(0.20f, 0.50f)});
-
-            if (stl::chance(10)) AddSliderToSet(set, Slider{"LabiaMorePuffyness_v2", stl::random(0.0f, 0.35f)});
-
-            AddSliderToSet(set, Slider{"Labiaprotrude", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaprotrude2", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaprotrudeback", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Labiaspread", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"LabiaCrumpled_v2", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"LabiaBulgogi_v2", stl::random(0.0f, 1.0f)});
-
-            if (stl::chance(40)) AddSliderToSet(set, Slider{"LabiaNeat_v2", stl::random(0.0f, 0.25f)});
-
-            AddSliderToSet(set, Slider{"VaginaHole", stl::random(0.0f, 1.0f)});
-            AddSliderToSet(set, Slider{"Clit", stl::random(-0.4f, 0.25f)});
-        }
-
-        AddSliderToSet(set, Slider{"Vaginasize", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"ClitSwell_v2", stl::random(-0.3f, 1.1f)});
-        AddSliderToSet(set, Slider{"Cutepuffyness", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"LabiaTightUp", stl::random(0.0f, 1.0f)});
-
-        if (stl::chance(60))
-            AddSliderToSet(set, Slider{"CBPC", stl::random(-0.25f, 0.25f)});
-        else
-            AddSliderToSet(set, Slider{"CBPC", stl::random(0.6f, 1.0f)});
-
-        AddSliderToSet(set, Slider{"AnalPosition_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalTexPos_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalTexPosRe_v2", stl::random(0.0f, 1.0f)});
-        AddSliderToSet(set, Slider{"AnalLoose_v2", -0.1F});
-
-        return set;
-    }
-
-    PresetManager::SliderSet OBody::GenerateClotheSliders(RE::Actor* a_actor) const {
         PresetManager::SliderSet set;
         // breasts
         // make area on sides behind breasts not sink in
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastSideShape", 0.0F));
+        AddSliderToSet(set, derive(kBreastSideShape, 0.0F));
         // make area under breasts not sink in
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastUnderDepth", 0.0F));
+        AddSliderToSet(set, derive(kBreastUnderDepth, 0.0F));
         // push breasts together
-        AddSliderToSet(set, DeriveSlider(a_actor, "BreastCleavage", 1.0F));
+        AddSliderToSet(set, derive(kBreastCleavage, 1.0F));
         // push up smaller breasts more
         AddSliderToSet(set, Slider{"BreastGravity2", -0.1F, -0.05F});
         // Make top of breast rise higher
@@ -495,48 +399,41 @@ namespace Body {
 
         // butt
         // remove butt impressions
-        AddSliderToSet(set, DeriveSlider(a_actor, "ButtDimples", 0.0F));
-        AddSliderToSet(set, DeriveSlider(a_actor, "ButtUnderFold", 0.0F));
+        AddSliderToSet(set, derive(kButtDimples, 0.0F));
+        AddSliderToSet(set, derive(kButtUnderFold, 0.0F));
         // shrink ass slightly
         AddSliderToSet(set, Slider{"AppleCheeks", -0.05F});
         AddSliderToSet(set, Slider{"Butt", -0.05F});
 
         // Torso
         // remove definition on clavical bone
-        AddSliderToSet(set, DeriveSlider(a_actor, "Clavicle_v2", 0.0F));
+        AddSliderToSet(set, derive(kClavicle, 0.0F));
         // Push out navel
-        AddSliderToSet(set, DeriveSlider(a_actor, "NavelEven", 1.0F));
+        AddSliderToSet(set, derive(kNavelEven, 1.0F));
 
         // hip
         // remove defintion on hip bone
-        AddSliderToSet(set, DeriveSlider(a_actor, "HipCarved", 0.0F));
+        AddSliderToSet(set, derive(kHipCarved, 0.0F));
 
         if (setNippleSlidersRefitEnabled) {
             // nipple
             // sublte change to tip shape
-            AddSliderToSet(set, DeriveSlider(a_actor, "NippleDip", 0.0F));
-            AddSliderToSet(set, DeriveSlider(a_actor, "NippleTip", 0.0F));
+            AddSliderToSet(set, derive(kNippleDip, 0.0F));
+            AddSliderToSet(set, derive(kNippleTip, 0.0F));
             // flatten areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipplePuffy_v2", 0.0F));
+            AddSliderToSet(set, derive(kNipplePuffy, 0.0F));
             // shrink areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "AreolaSize", -0.3F));
+            AddSliderToSet(set, derive(kAreolaSize, -0.3F));
             // flatten nipple
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipBGone", 1.0F));
-            // AddSliderToSet(set, DeriveSlider(a_actor, "NippleManga", -0.75f));
+            AddSliderToSet(set, derive(kNipBGone, 1.0F));
             //  push nipples together
             AddSliderToSet(set, Slider{"NippleDistance", 0.05F, 0.08F});
             // Lift large breasts up
             AddSliderToSet(set, Slider{"NippleDown", 0.0F, -0.1F});
             // Flatten nipple + areola
-            AddSliderToSet(set, DeriveSlider(a_actor, "NipplePerkManga", -0.25F));
-            // Flatten nipple
-            // AddSliderToSet(set, DeriveSlider(a_actor, "NipplePerkiness", 0.0f));
+            AddSliderToSet(set, derive(kNipplePerkManga, -0.25F));
         }
 
         return set;
     }
-
-    Slider OBody::DeriveSlider(RE::Actor* a_actor, const char* a_morph, float a_target) const {
-        return Slider{a_morph, a_target - GetMorph(a_actor, a_morph)};
-    }
 }  // namespace Body
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "PresetManager/PresetManager.h"
-#include "SKEE.h"
+#include "Body/MorphTransaction.h"
+#include "PresetManager/RandomSliders.h"
 
 namespace Body {
     inline SKSE::RegistrationSet<RE::Actor*, std::string> OnActorGenerated("OnActorGenerated"sv);
@@ -21,20 +21,25 @@ namespace Body {
         bool SetMorphInterface(SKEE::IBodyMorphInterface* a_morphInterface);
 
         void SetMorph(RE::Actor* a_actor, const char* a_morphName, const char* a_key, float a_value) const;
-        float GetMorph(RE::Actor* a_actor, const char* a_morphName) const;
         void ApplyMorphs(RE::Actor* a_actor, bool updateMorphsWithoutTimer, bool applyProcessedMorph = true) const;
 
         void ProcessActorEquipEvent(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor) const;
 
         void GenerateActorBody(RE::Actor* a_actor) const;
         void GenerateBodyByName(RE::Actor* a_actor, const std::string& a_name) const;
-        void GenerateBodyByPreset(RE::Actor* a_actor, PresetManager::Preset& a_preset,
+        void GenerateBodyByPreset(RE::Actor* a_actor, const PresetManager::Preset& a_preset,
                                   bool updateMorphsWithoutTimer) const;
 
-        void ApplySlider(RE::Actor* a_actor, const PresetManager::Slider& a_slider, const char* a_key,
-                         float a_weight) const;
-        void ApplySliderSet(RE::Actor* a_actor, PresetManager::SliderSet& a_sliders, const char* a_key) const;
-        void ApplyClothePreset(RE::Actor* a_actor) const;
+        static void ApplySlider(MorphTransaction& a_morphs, const PresetManager::Slider& a_slider, const char* a_key,
+                                float a_weight);
+        static void ApplySliderSet(MorphTransaction& a_morphs, const PresetManager::SliderSet& a_sliders,
+                                   const char* a_key);
+        static void ApplyRandomSliders(MorphTransaction& a_morphs, const PresetManager::RandomSliders& a_sliders,
+                                       const char* a_key);
+
+        // Returns whether any morph changed, so callers only have RaceMenu update the body when it has to
+        bool ApplyClothePreset(RE::Actor* a_actor) const;
+        void ApplyClothePreset(MorphTransaction& a_morphs) const;
         void RemoveClothePreset(RE::Actor* a_actor) const;
         void ClearActorMorphs(RE::Actor* a_actor) const;
 
@@ -47,11 +52,7 @@ namespace Body {
         bool IsProcessed(RE::Actor* a_actor) const;
         bool IsBlacklisted(RE::Actor* a_actor) const;
 
-        static PresetManager::SliderSet GenerateRandomNippleSliders();
-        static PresetManager::SliderSet GenerateRandomGenitalSliders();
-        PresetManager::SliderSet GenerateClotheSliders(RE::Actor* a_actor) const;
-
-        PresetManager::Slider DeriveSlider(RE::Actor* a_actor, const char* a_morph, float a_target) const;
+        PresetManager::SliderSet GenerateClotheSliders(const MorphTransaction& a_morphs) const;
 
         bool synthesisInstalled = false;
 
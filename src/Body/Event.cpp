@@ -37,12 +37,12 @@ RE::BSEventNotifyControl Event::OBodyEventHandler::ProcessEvent(const RE::TESLoa
             "Please exit the game now and refer to the OBody NG mod page for more information.");
     }
 
-    if (parser.invalid_presets != 0) {
+    if (const std::size_t invalid_presets{parser.invalid_presets}; invalid_presets != 0) {
         char message[256];
         sprintf_s(message, std::size(message),
                   "There was(were) %zu invalid preset(s) with parsing error(s), they won't be loaded in but are "
                   "logged in OBody.log. Look for \"load failed: {filename} [{error description}]\" in the log.",
-                  parser.invalid_presets);  // max length possible: 187
+                  invalid_presets);  // max length possible: 187
         RE::DebugMessageBox(message);
     }
 
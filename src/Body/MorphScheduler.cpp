@@ -0,0 +1,99 @@
+#include "Body/MorphScheduler.h"
+
+Body::MorphScheduler Body::MorphScheduler::instance;
+
+namespace Body {
+    MorphScheduler& MorphScheduler::GetInstance() { return instance; }
+
+    MorphScheduler::~MorphScheduler() {
+        // The worker uses the queue, the lock and the task interface, so it has to be gone before any of them is
+        {
+            const std::scoped_lock guard{lock};
+            stopping = true;
+        }
+
+        wakeup.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    void MorphScheduler::Schedule(const RE::ActorHandle& a_actor, const Clock::duration a_delay, Task a_task) {
+        const auto handle{a_actor.native_handle()};
+        if (!handle) return;
+
+        const auto due{Clock::now() + a_delay};
+        {
+            const std::scoped_lock guard{lock};
+            if (stopping) return;
+            if (!worker.joinable()) worker = std::thread{[this] { Run(); }};
+
+            auto [it, inserted]{pending.try_emplace(handle)};
+            auto& entry{it->second};
+            entry.actor = a_actor;
+            entry.task = std::move(a_task);
+            if (!inserted && entry.due <= due) return;
+
+            entry.due = due;
+            entry.generation = ++nextGeneration;
+            queue.push({due, handle, entry.generation});
+        }
+
+        wakeup.notify_one();
+    }
+
+    bool MorphScheduler::Cancel(const RE::ActorHandle& a_actor) {
+        const std::scoped_lock guard{lock};
+        return pending.erase(a_actor.native_handle()) != 0;
+    }
+
+    void MorphScheduler::CancelAll() {
+        {
+            const std::scoped_lock guard{lock};
+            pending.clear();
+            queue = {};
+        }
+
+        wakeup.notify_one();
+    }
+
+    std::size_t MorphScheduler::size() const {
+        const std::scoped_lock guard{lock};
+        return pending.size();
+    }
+
+    void MorphScheduler::Run() {
+        std::unique_lock guard{lock};
+        while (!stopping) {
+            if (queue.empty()) {
+                wakeup.wait(guard, [this] { return stopping || !queue.empty(); });
+                continue;
+            }
+
+            const auto next{queue.top()};
+            if (Clock::now() < next.due) {
+                // Also wakes up early for an update that is due sooner, once the queue was cleared, or to stop
+                wakeup.wait_until(guard, next.due, [this, &next] {
+                    return stopping || queue.empty() || queue.top().due < next.due;
+                });
+                continue;
+            }
+
+            queue.pop();
+            const auto it{pending.find(next.handle)};
+            if (it == pending.end() || it->second.generation != next.generation) continue;
+
+            auto actor{it->second.actor};
+            auto task{std::move(it->second.task)};
+            pending.erase(it);
+
+            guard.unlock();
+            SKSE::GetTaskInterface()->AddTask([actor, task = std::move(task)] {
+                if (const auto ptr{actor.get()}) {
+                    task(ptr.get());
+                } else {
+                    logger::info("Actor is no longer valid, not updating morphs");
+                }
+            });
+            guard.lock();
+        }
+    }
+}  // namespace Body
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace Body {
+    // Delayed morph updates, so RaceMenu doesn't have to re-evaluate every NPC of a freshly loaded cell in the same
+    // frame. One worker thread keeps the pending actors in a min-heap ordered by due time and hands each due update to
+    // the SKSE task interface, so it runs on the game's main thread. The worker is started by the first Schedule and
+    // runs until the scheduler is destroyed, which stops and joins it; updates still pending by then are dropped. An
+    // actor has at most one pending update: scheduling it again replaces the task and keeps whichever due time is
+    // earlier.
+    class MorphScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Runs on the main thread, and only if the actor still exists by then
+        using Task = std::function<void(RE::Actor*)>;
+
+        MorphScheduler(MorphScheduler&&) = delete;
+        MorphScheduler(const MorphScheduler&) = delete;
+
+        MorphScheduler& operator=(MorphScheduler&&) = delete;
+        MorphScheduler& operator=(const MorphScheduler&) = delete;
+
+        static MorphScheduler& GetInstance();
+
+        void Schedule(const RE::ActorHandle& a_actor, Clock::duration a_delay, Task a_task);
+
+        // Returns whether the actor had a pending update. One that was already handed to the main thread still runs.
+        bool Cancel(const RE::ActorHandle& a_actor);
+        void CancelAll();
+
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        struct Pending {
+            RE::ActorHandle actor;
+            Clock::time_point due;
+            std::uint64_t generation{};
+            Task task;
+        };
+
+        // Heap entries are never removed early. One whose generation no longer matches its actor's pending update was
+        // cancelled or rescheduled and is skipped when it comes up.
+        struct Entry {
+            Clock::time_point due;
+            std::uint32_t handle{};
+            std::uint64_t generation{};
+
+            bool operator>(const Entry& a_other) const { return due > a_other.due; }
+        };
+
+        MorphScheduler() = default;
+        ~MorphScheduler();
+
+        static MorphScheduler instance;
+
+        void Run();
+
+        mutable std::mutex lock;
+        std::condition_variable wakeup;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+        std::unordered_map<std::uint32_t, Pending> pending;  // native actor handle to its pending update
+        std::uint64_t nextGeneration{};
+        bool stopping{};
+        std::thread worker;
+    };
+}  // namespace Body
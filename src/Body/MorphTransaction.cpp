@@ -0,0 +1,121 @@
+#include "Body/MorphTransaction.h"
+
+namespace Body {
+    MorphTransaction::MorphTransaction(SKEE::IBodyMorphInterface* a_interface, RE::Actor* a_actor,
+                                       const std::span<const std::string_view> a_keys,
+                                       const std::span<const char* const> a_watched)
+        : morphInterface(a_interface),
+          actor(a_actor),
+          watchedKey(a_keys.empty() ? std::string_view{} : a_keys.front()),
+          watchedNames(a_watched),
+          watched(a_watched.size()) {
+        for (const auto key : a_keys) keys.try_emplace(std::string{key});
+
+        // RaceMenu has no way to visit a single key, so every morph of the actor comes through here. Only the ones
+        // under the transaction's keys are indexed; of the rest just the key is remembered.
+        class Reader final : public SKEE::IBodyMorphInterface::MorphValueVisitor {
+        public:
+            explicit Reader(MorphTransaction& a_transaction) : transaction(a_transaction) {}
+
+            void Visit(RE::TESObjectREFR*, const char* a_morph, const char* a_key, const float a_value) override {
+                if (!a_morph || !a_key) return;
+
+                if (!transaction.keys.contains(std::string_view{a_key})) {
+                    constexpr stl::iequal equal;
+                    auto& others{transaction.otherKeys};
+                    if (std::ranges::none_of(others, [&](const auto& a_other) { return equal(a_other, a_key); })) {
+                        others.emplace_back(a_key);
+                    }
+                } else if (!transaction.IndexOf(a_morph, a_key)) {
+                    transaction.Add(a_morph, a_key, a_value, a_value);
+                }
+            }
+
+        private:
+            MorphTransaction& transaction;
+        };
+
+        Reader reader{*this};
+        morphInterface->VisitMorphValues(actor, reader);
+    }
+
+    std::optional<std::size_t> MorphTransaction::IndexOf(const std::string_view a_morph,
+                                                         const std::string_view a_key) const {
+        if (const auto it{index.find(IdView{a_morph, a_key})}; it != index.end()) return it->second;
+        return std::nullopt;
+    }
+
+    void MorphTransaction::Add(const std::string_view a_morph, const std::string_view a_key,
+                               const std::optional<float> a_current, const float a_target) {
+        const auto position{morphs.size()};
+        const auto it{index.try_emplace(Id{a_morph, a_key}, position).first};
+        morphs.push_back({&it->first, a_current.value_or(0.0f), a_target, a_current.has_value(), true});
+
+        auto slot{keys.find(a_key)};
+        if (slot == keys.end()) slot = keys.try_emplace(std::string{a_key}).first;
+        slot->second.push_back(position);
+
+        constexpr stl::iequal equal;
+        if (watchedNames.empty() || !equal(a_key, watchedKey)) return;
+        for (std::size_t i{}; i < watchedNames.size(); ++i) {
+            if (equal(a_morph, watchedNames[i])) {
+                watched[i] = position;
+                break;
+            }
+        }
+    }
+
+    float MorphTransaction::Get(const std::string_view a_morph, const std::string_view a_key) const {
+        const auto position{IndexOf(a_morph, a_key)};
+        return position && morphs[*position].keep ? morphs[*position].target : 0.0f;
+    }
+
+    float MorphTransaction::GetWatched(const std::size_t a_slot) const {
+        const auto position{watched[a_slot]};
+        return position && morphs[*position].keep ? morphs[*position].target : 0.0f;
+    }
+
+    void MorphTransaction::Set(const std::string_view a_morph, const std::string_view a_key, const float a_value) {
+        if (const auto position{IndexOf(a_morph, a_key)}) {
+            morphs[*position].target = a_value;
+            morphs[*position].keep = true;
+        } else {
+            Add(a_morph, a_key, std::nullopt, a_value);
+        }
+    }
+
+    void MorphTransaction::ClearKey(const std::string_view a_key) {
+        if (const auto it{keys.find(a_key)}; it != keys.end()) {
+            for (const auto position : it->second) morphs[position].keep = false;
+        }
+    }
+
+    void MorphTransaction::ClearAll() {
+        for (auto& morph : morphs) morph.keep = false;
+        clearOtherKeys = !otherKeys.empty();
+    }
+
+    bool MorphTransaction::Commit() {
+        bool changed{};
+        if (clearOtherKeys) {
+            for (const auto& key : otherKeys) morphInterface->ClearBodyMorphKeys(actor, key.c_str());
+            otherKeys.clear();
+            clearOtherKeys = false;
+            changed = true;
+        }
+
+        for (auto& morph : morphs) {
+            if (morph.keep && (!morph.exists || morph.current != morph.target)) {
+                morphInterface->SetMorph(actor, morph.id->first.c_str(), morph.id->second.c_str(), morph.target);
+                morph.current = morph.target;
+                morph.exists = changed = true;
+            } else if (!morph.keep && morph.exists) {
+                morphInterface->ClearMorph(actor, morph.id->first.c_str(), morph.id->second.c_str());
+                morph.exists = false;
+                changed = true;
+            }
+        }
+
+        return changed;
+    }
+}  // namespace Body
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "SKEE.h"
+#include "STLCore.h"
+
+namespace Body {
+    // Morph values OBody wants an actor to end up with under its own keys. The actor's current morphs under those keys
+    // are read once with VisitMorphValues when the transaction starts, and Commit only sends the SetMorph and ClearMorph
+    // calls that change something, so reapplying the same preset or outfit doesn't make RaceMenu re-evaluate the body.
+    // Morphs other mods keep under their own keys aren't indexed, only the names of those keys are kept for ClearAll.
+    class MorphTransaction {
+    public:
+        // a_keys are the keys the transaction reads back and writes, the first one being where a_watched live.
+        // a_watched names morphs that are read often. Their positions are kept in a dense array indexed like a_watched,
+        // filled by the same VisitMorphValues pass, so GetWatched doesn't look them up by name. a_watched has to
+        // outlive the transaction.
+        MorphTransaction(SKEE::IBodyMorphInterface* a_interface, RE::Actor* a_actor,
+                         std::span<const std::string_view> a_keys, std::span<const char* const> a_watched = {});
+
+        MorphTransaction(const MorphTransaction&) = delete;
+        MorphTransaction& operator=(const MorphTransaction&) = delete;
+
+        [[nodiscard]] RE::Actor* GetActor() const { return actor; }
+
+        // Value the morph will have after Commit, 0 if it won't be set
+        [[nodiscard]] float Get(std::string_view a_morph, std::string_view a_key) const;
+
+        // Same as Get(a_watched[a_slot], a_keys.front())
+        [[nodiscard]] float GetWatched(std::size_t a_slot) const;
+
+        // Setting a morph again overrides the earlier value, same as calling SetMorph twice. a_key should be one of the
+        // transaction's keys; a morph under any other key is always sent, as nothing was read back for it.
+        void Set(std::string_view a_morph, std::string_view a_key, float a_value);
+
+        // Every morph under a_key, one of the transaction's keys, that isn't set again before Commit gets cleared
+        void ClearKey(std::string_view a_key);
+
+        // Every morph of the actor that isn't set again before Commit gets cleared, like ClearMorphs. Other mods' keys
+        // are cleared as a whole with ClearBodyMorphKeys.
+        void ClearAll();
+
+        // Sends the differences to RaceMenu. Returns whether any morph changed, i.e. whether the body needs updating.
+        bool Commit();
+
+    private:
+        // Morph name and key. RaceMenu matches both case-insensitively.
+        using Id = std::pair<std::string, std::string>;
+        using IdView = std::pair<std::string_view, std::string_view>;
+
+        struct IdHash {
+            using is_transparent = void;
+
+            std::size_t operator()(const IdView& a_id) const noexcept {
+                constexpr stl::ihash hash;
+                return hash(a_id.first) * 31 ^ hash(a_id.second);
+            }
+        };
+
+        struct IdEqual {
+            using is_transparent = void;
+
+            bool operator()(const IdView& a_id1, const IdView& a_id2) const {
+                constexpr stl::iequal equal;
+                return equal(a_id1.first, a_id2.first) && equal(a_id1.second, a_id2.second);
+            }
+        };
+
+        struct Morph {
+            const Id* id{};   // owned by index, whose nodes don't move
+            float current{};  // value the actor has, if it has the morph
+            float target{};   // value Commit leaves it with, if it is kept
+            bool exists{};
+            bool keep{};
+        };
+
+        // Position of the morph in morphs, nothing if neither the actor has it nor it was set
+        [[nodiscard]] std::optional<std::size_t> IndexOf(std::string_view a_morph, std::string_view a_key) const;
+
+        // Adds a morph that isn't there yet, a_current being the value the actor has if it has the morph
+        void Add(std::string_view a_morph, std::string_view a_key, std::optional<float> a_current, float a_target);
+
+        SKEE::IBodyMorphInterface* morphInterface;
+        RE::Actor* actor;
+        std::vector<Morph> morphs;
+        std::unordered_map<Id, std::size_t, IdHash, IdEqual> index;  // position of every morph in morphs
+        std::unordered_map<std::string, std::vector<std::size_t>, stl::ihash, stl::iequal> keys;  // positions per key
+        std::vector<std::string> otherKeys;  // keys the actor has morphs under that aren't the transaction's
+        bool clearOtherKeys{};
+        std::string watchedKey;
+        std::span<const char* const> watchedNames;
+        std::vector<std::optional<std::size_t>> watched;  // position in morphs of every watched morph it holds
+    };
+}  // namespace Body
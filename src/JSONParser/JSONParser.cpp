@@ -12,8 +12,8 @@ namespace Parser {
         return form->sourceFiles.array;  // Check if the source files array exists
     }
 
-    std::string GetNthFormLocationName(const RE::TESForm* form, const uint32_t n) {
-        std::string formName;
+    std::string_view GetNthFormLocationName(const RE::TESForm* form, const uint32_t n) {
+        std::string_view formName;
 
         if (GetHasSourceFileArray(form) && form->sourceFiles.array->size() > n) {
             RE::TESFile** sourceFiles = form->sourceFiles.array->data();
@@ -31,220 +31,203 @@ namespace Parser {
         return formName;
     }
 
-    bool IsActorInForm(const RE::TESNPC* form, const std::string_view target) {
-        if (GetHasSourceFileArray(form) && !form->sourceFiles.array->empty()) {
-            RE::TESFile** sourceFiles{form->sourceFiles.array->data()};
-
-            for (int i{}; i < form->sourceFiles.array->size(); i++) {
-                if (sourceFiles[i]->fileName == target) {
-                    return true;
-                }
-            }
-        }
+    uint32_t GetPluginKey(const RE::TESFile* a_file) {
+        // Light plugins share the FE slot, so they get their own range after the 0xFF full plugins
+        return (a_file->IsLight() ? 0x100u + a_file->smallFileCompileIndex : a_file->compileIndex) + 1u;
+    }
 
-        return false;
+    // Plugin key of the file that first defines the form, with the same Skyrim.esm fix as GetNthFormLocationName.
+    // Skyrim.esm always loads first, so its key is that of compile index 0.
+    uint32_t GetOwningPluginKey(const RE::TESForm* form) {
+        if ((form->formID & 0xFF000000) == 0) return 1;
+        if (!GetHasSourceFileArray(form) || form->sourceFiles.array->empty()) return 0;
+        return GetPluginKey(form->sourceFiles.array->data()[0]);
     }
 
     bool JSONParser::IsActorInBlacklistedCharacterCategorySet(const uint32_t formID) const {
-        for (const auto a_formID : blacklistedCharacterCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
-
-        return false;
+        return blacklistedCharacterCategorySet.contains(formID);
     }
 
-    bool JSONParser::IsOutfitInBlacklistedOutfitCategorySet(const uint32_t formID) {
-        for (const auto a_formID : blacklistedOutfitCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
-
-        return false;
+    bool JSONParser::IsOutfitInBlacklistedOutfitCategorySet(const uint32_t formID) const {
+        return blacklistedOutfitCategorySet.contains(formID);
     }
 
     bool JSONParser::IsOutfitInForceRefitCategorySet(const uint32_t formID) const {
-        for (const auto a_formID : forceRefitOutfitCategorySet | std::views::transform(&categorizedList::formID)) {
-            if (a_formID == formID) {
-                return true;
-            }
-        }
+        return forceRefitOutfitCategorySet.contains(formID);
+    }
 
-        return false;
+    const categorizedList* JSONParser::GetNPCFromCategorySet(const uint32_t formID) const {
+        const auto* const index{characterCategoryIndex.find(formID)};
+        return index ? &characterCategorySet[*index] : nullptr;
     }
 
-    std::optional<categorizedList> JSONParser::GetNPCFromCategorySet(const uint32_t formID) const {
-        for (const categorizedList& character : characterCategorySet) {
-            if (character.formID == formID) {
-                return character;
+    // Preset list of one rule. Entries are either a preset name or {"name": ..., "weight": ...}, where a missing weight
+    // counts as 1; the weights are only kept if at least one entry has one. A weight of 0 disables its preset, so it
+    // isn't a candidate at all, and a rule whose presets are all disabled is rejected: it returns nothing.
+    std::optional<PresetCandidates> ReadPresetCandidates(const rapidjson::Value& a_presets,
+                                                         const std::string_view a_rule) {
+        PresetCandidates ret;
+        if (!a_presets.IsArray()) return ret;
+
+        ret.names.reserve(a_presets.Size());
+        ret.weights.reserve(a_presets.Size());
+        bool weighted{};
+        std::size_t disabled{};
+        for (const auto& item : a_presets.GetArray()) {
+            if (item.IsString()) {
+                ret.names.emplace_back(item.GetString());
+                ret.weights.push_back(1.0f);
+            } else if (item.IsObject()) {
+                const auto name{item.FindMember("name")};
+                if (name == item.MemberEnd() || !name->value.IsString()) continue;
+
+                const auto weight{item.FindMember("weight")};
+                const bool hasWeight{weight != item.MemberEnd() && weight->value.IsNumber()};
+                const float value{hasWeight ? weight->value.GetFloat() : 1.0f};
+                weighted |= hasWeight;
+                if (!(value > 0.0f)) {
+                    logger::info("Preset '{}' in '{}' has a weight of 0, dropping it", name->value.GetString(), a_rule);
+                    ++disabled;
+                    continue;
+                }
+
+                ret.names.emplace_back(name->value.GetString());
+                ret.weights.push_back(value);
             }
         }
 
-        return {};
-    }
+        if (ret.names.empty() && disabled > 0) {
+            logger::warn("Every preset in '{}' has a weight of 0, ignoring the rule", a_rule);
+            return std::nullopt;
+        }
 
-    inline std::string DiscardFormDigits(const std::string_view formID, const RE::TESFile* mod) {
-        char temp[9]{"00000000"};
-        std::memcpy(temp + (8 - formID.length()), formID.data(), formID.length());
-        return std::string(temp + (mod->IsLight() ? 5 : 2));
+        if (!weighted) ret.weights.clear();
+        return ret;
     }
 
-    void JSONParser::ProcessNPCsFormID() {
-        const auto npcFormIDItr{presetDistributionConfig.FindMember("npcFormID")};
-        logger::info(TitleFormatSpecifier, npcFormIDItr->name.GetString());
-        if (npcFormIDItr != presetDistributionConfig.MemberEnd()) {
-            auto* const data_handler{RE::TESDataHandler::GetSingleton()};
-            auto& npcFormID{npcFormIDItr->value};
-            for (auto itr{npcFormID.MemberBegin()}; itr != npcFormID.MemberEnd();) {
-                auto& [owningMod, value]{*itr};
-                const auto* const file{data_handler->LookupModByName(owningMod.GetString())};
-                if (!file) {
-                    logger::info("removed '{}'", owningMod.GetString());
-                    itr = npcFormID.EraseMember(itr);
-                    continue;
-                }
-                for (auto valueItr = value.MemberBegin(); valueItr != value.MemberEnd(); ++valueItr) {
-                    auto& [formKey, formValue]{*valueItr};
-                    stl::RemoveDuplicatesInJsonArray(formValue, presetDistributionConfig.GetAllocator());
-                    std::string formID{DiscardFormDigits(formKey.GetString(), file)};
-
-                    uint32_t hexnumber;
-                    sscanf_s(formID.data(), "%x", &hexnumber);
+    // Hex FormID as written in the config, with or without a 0x prefix. Anything else, including more than eight
+    // digits, is rejected rather than guessed at.
+    std::optional<std::uint32_t> ParseFormID(std::string_view a_hex) {
+        if (a_hex.starts_with("0x") || a_hex.starts_with("0X")) a_hex.remove_prefix(2);
 
-                    const auto actorform = data_handler->LookupForm(hexnumber, owningMod.GetString());
+        std::uint32_t ret{};
+        const auto [ptr, ec]{std::from_chars(a_hex.data(), a_hex.data() + a_hex.size(), ret, 16)};
+        if (a_hex.empty() || ec != std::errc{} || ptr != a_hex.data() + a_hex.size()) return std::nullopt;
+        return ret;
+    }
 
-                    if (!actorform) {
-                        logger::info("{} is not a valid key!", formID);
-                        continue;
-                    }
+    // Turns the plugin-keyed FormID lists of the config into full FormIDs. Every plugin is looked up once, however
+    // many key families name it, and the FormIDs are built from its load order position the way
+    // TESDataHandler::LookupForm does, so the load order digits written in the config don't matter.
+    class FormIDResolver {
+    public:
+        const RE::TESFile* GetFile(const std::string_view a_plugin) {
+            if (const auto it{files.find(a_plugin)}; it != files.end()) return it->second;
+            return files.emplace(a_plugin, dataHandler->LookupModByName(a_plugin)).first->second;
+        }
 
-                    // We have to use this full-length ID in order to identify them.
-                    auto ID = actorform->GetFormID();
-                    std::vector<std::string> bodyslidePresets(formValue.GetArray().Size());
-                    for (const auto& item : formValue.GetArray()) {
-                        bodyslidePresets.emplace_back(item.GetString());
-                    }
+        // Returns 0 if the key isn't a FormID or no such form is loaded
+        std::uint32_t Resolve(const RE::TESFile* a_file, const std::string_view a_key) {
+            const RE::TESForm* form{};
+            if (const auto local{ParseFormID(a_key)}) {
+                const auto ID{a_file->IsLight() ? 0xFE000000 | (std::uint32_t{a_file->smallFileCompileIndex} << 12) |
+                                                      (*local & 0xFFF)
+                                                : (std::uint32_t{a_file->compileIndex} << 24) | (*local & 0xFFFFFF)};
+                form = RE::TESForm::LookupByID(ID);
+            }
 
-                    characterCategorySet.emplace_back(owningMod.GetString(), ID, std::move(bodyslidePresets));
-                }
-                ++itr;
+            if (!form) {
+                logger::info("{} is not a valid key!", a_key);
+                ++rejected;
+                return 0;
             }
-        }
-    }
 
-    void JSONParser::ProcessNPCsFormIDBlacklist() {
-        const auto blacklistedNpcsFormIDItr{presetDistributionConfig.FindMember("blacklistedNpcsFormID")};
-        logger::info(TitleFormatSpecifier, blacklistedNpcsFormIDItr->name.GetString());
-        if (blacklistedNpcsFormIDItr != presetDistributionConfig.MemberEnd()) {
-            auto* const data_handler{RE::TESDataHandler::GetSingleton()};
-            auto& blacklistedNpcsFormID{blacklistedNpcsFormIDItr->value};
-            for (auto itr{blacklistedNpcsFormID.MemberBegin()}; itr != blacklistedNpcsFormID.MemberEnd();) {
-                auto& [plugin, val] = *itr;
-                const auto* const file{data_handler->LookupModByName(plugin.GetString())};
-                if (!file) {
-                    logger::info("removed '{}'", plugin.GetString());
-                    itr = blacklistedNpcsFormID.EraseMember(itr);
-                    continue;
-                }
-                stl::RemoveDuplicatesInJsonArray(val, presetDistributionConfig.GetAllocator());
-                for (const auto& formIDRaw : val.GetArray()) {
-                    std::string formID{DiscardFormDigits(formIDRaw.GetString(), file)};
-                    uint32_t hexnumber;
-                    sscanf_s(formID.data(), "%x", &hexnumber);
+            ++resolved;
+            return form->GetFormID();
+        }
 
-                    const auto actorform = data_handler->LookupForm(hexnumber, plugin.GetString());
+        std::size_t resolved{};
+        std::size_t rejected{};
+
+    private:
+        RE::TESDataHandler* dataHandler{RE::TESDataHandler::GetSingleton()};
+        // Owns its keys: plugin names in the DOM move whenever ResolveFormIDs erases a member before them
+        std::unordered_map<std::string, const RE::TESFile*, stl::ihash, stl::iequal> files;
+    };
+
+    // Every FormID key family maps plugin names either to an array of FormIDs or, like npcFormID, to an object of
+    // FormIDs and their preset lists; a_sink gets the resolved FormID and the preset list, if there is one. Plugins
+    // that aren't loaded are removed from the config.
+    template <class F>
+    void ResolveFormIDs(rapidjson::Document& a_config, const char* a_key, FormIDResolver& a_resolver, F&& a_sink) {
+        logger::info(TitleFormatSpecifier, a_key);
+
+        const auto member{a_config.FindMember(a_key)};
+        if (member == a_config.MemberEnd() || !member->value.IsObject()) return;
+
+        auto& plugins{member->value};
+        for (auto itr{plugins.MemberBegin()}; itr != plugins.MemberEnd();) {
+            auto& [plugin, value]{*itr};
+            const auto* const file{a_resolver.GetFile(plugin.GetString())};
+            if (!file) {
+                logger::info("removed '{}'", plugin.GetString());
+                a_resolver.rejected += value.IsObject() ? value.MemberCount() : value.IsArray() ? value.Size() : 0;
+                itr = plugins.EraseMember(itr);
+                continue;
+            }
 
-                    if (!actorform) {
-                        logger::info("{} is not a valid key!", formID);
-                        continue;
+            if (value.IsObject()) {
+                for (auto& [formID, presets] : value.GetObject()) {
+                    if (const auto ID{a_resolver.Resolve(file, formID.GetString())}) {
+                        a_sink(plugin.GetString(), ID, &presets);
+                    }
+                }
+            } else if (value.IsArray()) {
+                stl::RemoveDuplicatesInJsonArray(value, a_config.GetAllocator());
+                for (const auto& formID : value.GetArray()) {
+                    if (const auto ID{a_resolver.Resolve(file, formID.GetString())}) {
+                        a_sink(plugin.GetString(), ID, nullptr);
                     }
-
-                    // We have to use this full-length ID in order to identify them.
-                    auto ID = actorform->GetFormID();
-
-                    blacklistedCharacterCategorySet.emplace_back(plugin.GetString(), ID);
                 }
-                ++itr;
             }
+            ++itr;
         }
     }
 
-    void JSONParser::ProcessOutfitsFormIDBlacklist() {
-        const auto blacklistedOutfitsFromORefitFormIDItr{
-            presetDistributionConfig.FindMember("blacklistedOutfitsFromORefitFormID")};
-        logger::info(TitleFormatSpecifier, blacklistedOutfitsFromORefitFormIDItr->name.GetString());
-        if (blacklistedOutfitsFromORefitFormIDItr != presetDistributionConfig.MemberEnd()) {
-            auto* const data_handler{RE::TESDataHandler::GetSingleton()};
-            auto& blacklistedOutfitsFromORefitFormID{blacklistedOutfitsFromORefitFormIDItr->value};
-            for (auto itr{blacklistedOutfitsFromORefitFormID.MemberBegin()};
-                 itr != blacklistedOutfitsFromORefitFormID.MemberEnd();) {
-                auto& [plugin, val]{*itr};
-                const auto* const file{data_handler->LookupModByName(plugin.GetString())};
-                if (!file) {
-                    logger::info("removed '{}'", plugin.GetString());
-                    itr = blacklistedOutfitsFromORefitFormID.EraseMember(itr);
-                    continue;
-                }
-                stl::RemoveDuplicatesInJsonArray(val, presetDistributionConfig.GetAllocator());
-                for (const auto& formIDRaw : val.GetArray()) {
-                    std::string formID{DiscardFormDigits(formIDRaw.GetString(), file)};
-                    uint32_t hexnumber;
-                    sscanf_s(formID.data(), "%x", &hexnumber);
-
-                    const auto outfitform = data_handler->LookupForm(hexnumber, plugin.GetString());
+    void JSONParser::ProcessFormIDs() {
+        [[maybe_unused]] stl::timeit const t;
 
-                    if (!outfitform) {
-                        logger::info("{} is not a valid key!", formID);
-                        continue;
-                    }
+        FormIDResolver resolver;
 
-                    // We have to use this full-length ID in order to identify them.
-                    auto ID = outfitform->GetFormID();
+        ResolveFormIDs(presetDistributionConfig, "blacklistedNpcsFormID", resolver,
+                       [this](std::string_view, const std::uint32_t a_formID, rapidjson::Value*) {
+                           blacklistedCharacterCategorySet.insert(a_formID);
+                       });
 
-                    blacklistedOutfitCategorySet.emplace_back(plugin.GetString(), ID);
-                }
-                ++itr;
-            }
-        }
-    }
+        const auto addCharacter{[this](const std::string_view a_plugin, const std::uint32_t a_formID,
+                                       rapidjson::Value* a_presets) {
+            if (!a_presets) return;
+            stl::RemoveDuplicatesInJsonArray(*a_presets, presetDistributionConfig.GetAllocator());
 
-    void JSONParser::ProcessOutfitsForceRefitFormIDBlacklist() {
-        const auto outfitsForceRefitFormIDItr{presetDistributionConfig.FindMember("outfitsForceRefitFormID")};
-        logger::info(TitleFormatSpecifier, outfitsForceRefitFormIDItr->name.GetString());
-        if (outfitsForceRefitFormIDItr != presetDistributionConfig.MemberEnd()) {
-            auto* const data_handler{RE::TESDataHandler::GetSingleton()};
-            auto& outfitsForceRefitFormID{outfitsForceRefitFormIDItr->value};
-            for (auto itr{outfitsForceRefitFormID.MemberBegin()}; itr != outfitsForceRefitFormID.MemberEnd();) {
-                auto& [plugin, val]{*itr};
-                const auto* const file{data_handler->LookupModByName(plugin.GetString())};
-                if (!file) {
-                    logger::info("removed '{}'", plugin.GetString());
-                    itr = outfitsForceRefitFormID.EraseMember(itr);
-                    continue;
-                }
-                stl::RemoveDuplicatesInJsonArray(val, presetDistributionConfig.GetAllocator());
-                for (const auto& formIDRaw : val.GetArray()) {
-                    std::string formID{DiscardFormDigits(formIDRaw.GetString(), file)};
-                    uint32_t hexnumber;
-                    sscanf_s(formID.data(), "%x", &hexnumber);
+            auto candidates{
+                ReadPresetCandidates(*a_presets, std::format("npcFormID|{}|{:08X}", a_plugin, a_formID))};
+            if (!candidates) return;
 
-                    const auto outfitform = data_handler->LookupForm(hexnumber, plugin.GetString());
+            characterCategorySet.emplace_back(std::string{a_plugin}, a_formID, std::move(*candidates));
+        }};
+        ResolveFormIDs(presetDistributionConfig, "npcFormID", resolver, addCharacter);
 
-                    if (!outfitform) {
-                        logger::info("{} is not a valid key!", formID);
-                        continue;
-                    }
+        ResolveFormIDs(presetDistributionConfig, "blacklistedOutfitsFromORefitFormID", resolver,
+                       [this](std::string_view, const std::uint32_t a_formID, rapidjson::Value*) {
+                           blacklistedOutfitCategorySet.insert(a_formID);
+                       });
 
-                    // We have to use this full-length ID in order to identify them.
-                    auto ID = outfitform->GetFormID();
+        ResolveFormIDs(presetDistributionConfig, "outfitsForceRefitFormID", resolver,
+                       [this](std::string_view, const std::uint32_t a_formID, rapidjson::Value*) {
+                           forceRefitOutfitCategorySet.insert(a_formID);
+                       });
 
-                    forceRefitOutfitCategorySet.emplace_back(plugin.GetString(), ID);
-                }
-                ++itr;
-            }
-        }
+        logger::info("Resolved {} FormIDs, rejected {}", resolver.resolved, resolver.rejected);
     }
 
     inline bool ValidateActor(const RE::Actor* const actor) {
@@ -263,6 +246,46 @@ namespace Parser {
         return ((iterators != end) || ...);
     }
 
+    // Names of every loaded, valid NPC reference's base, read under the form table's lock. Actor::HasKeywordString and
+    // the other game accessors aren't safe to call from other threads, so the scan stays on the calling thread; the
+    // names stay owned by the forms.
+    stl::string_view_set ScanNPCNames() {
+        [[maybe_unused]] stl::timeit const t{"FilterOutNonLoaded: scanning NPC names"};
+
+        const auto& [hashtable, lock]{RE::TESForm::GetAllForms()};
+        const RE::BSReadLockGuard locker{lock};
+        if (!hashtable) return {};
+
+        std::vector<std::string_view> names;
+        for (auto& [_, form] : *hashtable) {
+            if (auto* const actor{form ? form->As<RE::Actor>() : nullptr};
+                ValidateActor(actor) && actor->HasKeywordString("ActorTypeNPC")) {
+                if (const char* const name{actor->GetBaseObject()->GetName()}) names.emplace_back(name);
+            }
+        }
+        return stl::string_view_set{std::move(names)};
+    }
+
+    stl::string_view_set ScanRaceEditorIDs() {
+        [[maybe_unused]] stl::timeit const t{"FilterOutNonLoaded: scanning race editor IDs"};
+
+        std::vector<std::string_view> editorIDs;
+        for (const auto* const race : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::TESRace>()) {
+            editorIDs.emplace_back(race->GetFormEditorID());
+        }
+        return stl::string_view_set{std::move(editorIDs)};
+    }
+
+    stl::string_view_set ScanArmorNames() {
+        [[maybe_unused]] stl::timeit const t{"FilterOutNonLoaded: scanning armor names"};
+
+        std::vector<std::string_view> names;
+        for (const auto* const armor : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::TESObjectARMO>()) {
+            names.emplace_back(armor->GetName());
+        }
+        return stl::string_view_set{std::move(names)};
+    }
+
     void JSONParser::FilterOutNonLoaded() {
         auto* const data_handler{RE::TESDataHandler::GetSingleton()};
         const auto end{presetDistributionConfig.MemberEnd()};
@@ -287,31 +310,91 @@ namespace Parser {
 
 #undef OBODY_DEFINITION
 
-        logger::info(TitleFormatSpecifier, "npc|blacklistedNpcs");
-        if (AnyNotEnd(end, npc, blacklistedNpcs)) {
-            std::set<std::string> npc_names;
-            {
-                const auto& [hashtable, lock]{RE::TESForm::GetAllForms()};
-                const RE::BSReadLockGuard locker{lock};
-                if (hashtable) {
-                    for (auto& [_, form] : *hashtable) {
-                        if (form) {
-                            if (auto* const actor{form->As<RE::Actor>()};
-                                ValidateActor(actor) && actor->HasKeywordString("ActorTypeNPC")) {
-                                if (const char* const name{actor->GetBaseObject()->GetName()}) {
-                                    npc_names.emplace(name);
-                                }
-                            }
-                        }
-                    }
+        // The scans read game data, so they run on this thread and only when a key needs them
+        stl::string_view_set npcNames, raceEditorIDs, armorNames;
+        if (AnyNotEnd(end, npc, blacklistedNpcs)) npcNames = ScanNPCNames();
+        if (AnyNotEnd(end, raceFemale, raceMale, blacklistedRacesFemale, blacklistedRacesMale)) {
+            raceEditorIDs = ScanRaceEditorIDs();
+        }
+        if (AnyNotEnd(end, blacklistedOutfitsFromORefit, outfitsForceRefit)) armorNames = ScanArmorNames();
+
+        const auto isNPC{[&](const char* a_name) { return npcNames.contains(a_name); }};
+        const auto isFaction{[](const char* a_name) { return RE::TESForm::LookupByEditorID(a_name) != nullptr; }};
+        const auto isPlugin{[=](const char* a_name) { return data_handler->LookupModByName(a_name) != nullptr; }};
+        const auto isRace{[&](const char* a_name) { return raceEditorIDs.contains(a_name); }};
+        const auto isArmor{[&](const char* a_name) { return armorNames.contains(a_name); }};
+
+        // One entry per config key: the object's member names or the array's strings are checked against what is
+        // loaded. Checks against the scanned sets only read plain data and run concurrently. Faction and plugin checks
+        // go through the game's lookups, which aren't documented as thread-safe, so they run on this thread, as does
+        // editing the document through its allocator.
+        struct Filter {
+            rapidjson::Document::MemberIterator member;
+            std::function<bool(const char*)> isLoaded;
+            bool gameLookup;
+            std::vector<bool> keep;
+        };
+
+        std::vector<Filter> filters;
+        for (auto&& [member, isLoaded, gameLookup] :
+             std::initializer_list<
+                 std::tuple<rapidjson::Document::MemberIterator, std::function<bool(const char*)>, bool>>{
+                 {npc, isNPC, false},
+                 {blacklistedNpcs, isNPC, false},
+                 {factionFemale, isFaction, true},
+                 {factionMale, isFaction, true},
+                 {npcPluginFemale, isPlugin, true},
+                 {npcPluginMale, isPlugin, true},
+                 {raceFemale, isRace, false},
+                 {raceMale, isRace, false},
+                 {blacklistedRacesFemale, isRace, false},
+                 {blacklistedRacesMale, isRace, false},
+                 {blacklistedNpcsPluginFemale, isPlugin, true},
+                 {blacklistedNpcsPluginMale, isPlugin, true},
+                 {blacklistedOutfitsFromORefit, isArmor, false},
+                 {outfitsForceRefit, isArmor, false},
+                 {blacklistedOutfitsFromORefitPlugin, isPlugin, true},
+             }) {
+            if (member == end) continue;
+            // Arrays lose their duplicates before they are checked, so the flags line up with what is left
+            if (member->value.IsArray()) {
+                stl::RemoveDuplicatesInJsonArray(member->value, presetDistributionConfig.GetAllocator());
+            }
+            filters.push_back({member, isLoaded, gameLookup, {}});
+        }
+
+        {
+            [[maybe_unused]] stl::timeit const t{"FilterOutNonLoaded: checking keys"};
+            const auto check{[](Filter& a_filter) {
+                auto& [member, isLoaded, _, keep]{a_filter};
+                if (member->value.IsObject()) {
+                    keep.reserve(member->value.MemberCount());
+                    for (const auto& item : member->value.GetObject()) keep.push_back(isLoaded(item.name.GetString()));
+                } else if (member->value.IsArray()) {
+                    keep.reserve(member->value.Size());
+                    for (const auto& item : member->value.GetArray()) keep.push_back(isLoaded(item.GetString()));
+                }
+            }};
+
+            std::vector<Filter*> concurrent;
+            for (auto& filter : filters) {
+                if (filter.gameLookup) {
+                    check(filter);
+                } else {
+                    concurrent.push_back(&filter);
                 }
             }
+            stl::parallel_for(concurrent.size(), [&](const std::size_t i) { check(*concurrent[i]); });
+        }
 
-            logger::info(TitleFormatSpecifier, npc->name.GetString());
-            if (AnyNotEnd(end, npc)) {
-                auto& original = npc->value;
-                for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                    if (!npc_names.contains(it->name.GetString())) {
+        [[maybe_unused]] stl::timeit const t{"FilterOutNonLoaded: removing keys"};
+        for (const auto& [member, isLoaded, gameLookup, keep] : filters) {
+            logger::info(TitleFormatSpecifier, member->name.GetString());
+            auto& original{member->value};
+            std::size_t i{};
+            if (original.IsObject()) {
+                for (auto it = original.MemberBegin(); it != original.MemberEnd(); ++i) {
+                    if (!keep[i]) {
                         logger::info("removed '{}'", it->name.GetString());
                         it = original.EraseMember(it);
                     } else {
@@ -319,14 +402,9 @@ namespace Parser {
                         ++it;
                     }
                 }
-            }
-
-            logger::info(TitleFormatSpecifier, blacklistedNpcs->name.GetString());
-            if (AnyNotEnd(end, blacklistedNpcs)) {
-                auto& original = blacklistedNpcs->value;
-                stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-                for (auto it = original.Begin(); it != original.End();) {
-                    if (!npc_names.contains(it->GetString())) {
+            } else if (original.IsArray()) {
+                for (auto it = original.Begin(); it != original.End(); ++i) {
+                    if (!keep[i]) {
                         logger::info("removed '{}'", it->GetString());
                         it = original.Erase(it);
                     } else {
@@ -335,244 +413,332 @@ namespace Parser {
                 }
             }
         }
+    }
 
-        logger::info(TitleFormatSpecifier, factionFemale->name.GetString());
-        if (AnyNotEnd(end, factionFemale)) {
-            auto& original = factionFemale->value;
-            for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                if (!RE::TESForm::LookupByEditorID(it->name.GetString())) {
-                    logger::info("removed '{}'", it->name.GetString());
-                    it = original.EraseMember(it);
-                } else {
-                    stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                    ++it;
-                }
-            }
+    void JSONParser::ProcessJSONCategories() {
+        [[maybe_unused]] stl::timeit const t;
+        logger::info(TitleFormatSpecifier, "Starting: Removing Not-Loaded Items");
+        ProcessFormIDs();
+        FilterOutNonLoaded();
+        logger::info(TitleFormatSpecifier, "Finished: Removing Not-Loaded Items");
+        rapidjson::StringBuffer buffer;
+        rapidjson::PrettyWriter writer(buffer);
+        presetDistributionConfig.Accept(writer);
+
+        logger::info("After Filtering: \n{}", buffer.GetString());
+
+        CompileRules();
+
+        // Everything is in the compiled tables now, so the DOM and its allocator can go
+        rapidjson::Document{}.Swap(presetDistributionConfig);
+    }
+
+    stl::string_set ReadStrings(const rapidjson::Document& a_config, const char* a_key) {
+        std::vector<std::string> ret;
+
+        const auto itr{a_config.FindMember(a_key)};
+        if (itr == a_config.MemberEnd() || !itr->value.IsArray()) return {};
+
+        ret.reserve(itr->value.Size());
+        for (const auto& item : itr->value.GetArray()) {
+            ret.emplace_back(item.GetString());
         }
 
-        logger::info(TitleFormatSpecifier, factionMale->name.GetString());
-        if (AnyNotEnd(end, factionMale)) {
-            auto& original = factionMale->value;
-            for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                if (!RE::TESForm::LookupByEditorID(it->name.GetString())) {
-                    logger::info("removed '{}'", it->name.GetString());
-                    it = original.EraseMember(it);
-                } else {
-                    stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                    ++it;
-                }
-            }
+        return stl::string_set{std::move(ret)};
+    }
+
+    stl::id_set ReadPluginKeys(const rapidjson::Document& a_config, const char* a_key) {
+        stl::id_set ret;
+
+        const auto itr{a_config.FindMember(a_key)};
+        if (itr == a_config.MemberEnd() || !itr->value.IsArray()) return ret;
+
+        auto* const data_handler{RE::TESDataHandler::GetSingleton()};
+        ret.reserve(itr->value.Size());
+        for (const auto& item : itr->value.GetArray()) {
+            if (const auto* const file{data_handler->LookupModByName(item.GetString())}) ret.insert(GetPluginKey(file));
         }
 
-        logger::info(TitleFormatSpecifier, npcPluginFemale->name.GetString());
-        if (AnyNotEnd(end, npcPluginFemale)) {
-            auto& original{npcPluginFemale->value};
-            for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                if (!data_handler->LookupModByName(it->name.GetString())) {
-                    logger::info("removed '{}'", it->name.GetString());
-                    it = original.EraseMember(it);
-                } else {
-                    stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                    ++it;
-                }
-            }
+        return ret;
+    }
+
+    stl::id_set ReadRaceIDs(const rapidjson::Document& a_config, const char* a_key,
+                            const std::unordered_map<std::string, std::uint32_t>& a_races) {
+        stl::id_set ret;
+
+        const auto itr{a_config.FindMember(a_key)};
+        if (itr == a_config.MemberEnd() || !itr->value.IsArray()) return ret;
+
+        ret.reserve(itr->value.Size());
+        for (const auto& item : itr->value.GetArray()) {
+            if (const auto race{a_races.find(item.GetString())}; race != a_races.end()) ret.insert(race->second);
         }
 
-        logger::info(TitleFormatSpecifier, npcPluginMale->name.GetString());
-        if (AnyNotEnd(end, npcPluginMale)) {
-            auto& original{npcPluginMale->value};
-            for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                if (!data_handler->LookupModByName(it->name.GetString())) {
-                    logger::info("removed '{}'", it->name.GetString());
-                    it = original.EraseMember(it);
-                } else {
-                    stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                    ++it;
-                }
+        return ret;
+    }
+
+    std::vector<PresetRule> ReadPresetRules(const rapidjson::Document& a_config, const char* a_key) {
+        std::vector<PresetRule> ret;
+
+        const auto itr{a_config.FindMember(a_key)};
+        if (itr == a_config.MemberEnd() || !itr->value.IsObject()) return ret;
+
+        ret.reserve(itr->value.MemberCount());
+        for (const auto& [key, value] : itr->value.GetObject()) {
+            if (auto candidates{ReadPresetCandidates(value, std::format("{}|{}", a_key, key.GetString()))}) {
+                ret.emplace_back(key.GetString(), std::move(*candidates));
             }
         }
-        logger::info(TitleFormatSpecifier, "raceFemale|raceMale|blacklistedRacesFemale|blacklistedRacesMale");
-        if (AnyNotEnd(end, raceFemale, raceMale, blacklistedRacesFemale, blacklistedRacesMale)) {
-            auto d = data_handler->GetFormArray<RE::TESRace>() | std::views::transform([&](const RE::TESRace* race) {
-                         return stl::get_editorID(race->As<RE::TESForm>());
-                     });
-            const std::set d_set(d.begin(), d.end());
-
-            logger::info(TitleFormatSpecifier, raceFemale->name.GetString());
-            if (AnyNotEnd(end, raceFemale)) {
-                auto& original = raceFemale->value;
-                for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                    if (!d_set.contains(it->name.GetString())) {
-                        logger::info("removed '{}'", it->name.GetString());
-                        it = original.EraseMember(it);
-                    } else {
-                        stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                        ++it;
-                    }
-                }
-            }
 
-            logger::info(TitleFormatSpecifier, raceMale->name.GetString());
-            if (AnyNotEnd(end, raceMale)) {
-                auto& original = raceMale->value;
-                for (auto it = original.MemberBegin(); it != original.MemberEnd();) {
-                    if (!d_set.contains(it->name.GetString())) {
-                        logger::info("removed '{}'", it->name.GetString());
-                        it = original.EraseMember(it);
-                    } else {
-                        stl::RemoveDuplicatesInJsonArray(it->value, presetDistributionConfig.GetAllocator());
-                        ++it;
-                    }
-                }
-            }
+        return ret;
+    }
 
-            logger::info(TitleFormatSpecifier, blacklistedRacesFemale->name.GetString());
-            if (AnyNotEnd(end, blacklistedRacesFemale)) {
-                auto& original = blacklistedRacesFemale->value;
-                stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-                for (auto it = original.Begin(); it != original.End();) {
-                    if (!d_set.contains(it->GetString())) {
-                        logger::info("removed '{}'", it->GetString());
-                        it = original.Erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
+    // Flattens randomSliders entries into tokens: {"name", "min", "max"} or {"name", "value"} with an optional
+    // "chance", or {"oneOf": [{"chance", "sliders": [...]}, ...]}. The names point into the DOM.
+    void ReadRandomSliderTokens(const rapidjson::Value& a_entries,
+                                std::vector<PresetManager::RandomSliderToken>& a_tokens) {
+        using Type = PresetManager::RandomSliderToken::Type;
+
+        // Any whole number, so 50.0 reads as 50. Anything else gives a chance Compile rejects, instead of silently
+        // becoming 100.
+        const auto readChance{[](const rapidjson::Value& a_item) {
+            const auto chance{a_item.FindMember("chance")};
+            if (chance == a_item.MemberEnd()) return 100;
+            if (chance->value.IsInt()) return chance->value.GetInt();
+            if (chance->value.IsNumber()) {
+                const auto value{chance->value.GetDouble()};
+                if (value >= 0.0 && value <= 100.0 && value == static_cast<int>(value)) return static_cast<int>(value);
             }
 
-            logger::info(TitleFormatSpecifier, blacklistedRacesMale->name.GetString());
-            if (AnyNotEnd(end, blacklistedRacesMale)) {
-                auto& original = blacklistedRacesMale->value;
-                stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-                for (auto it = original.Begin(); it != original.End();) {
-                    if (!d_set.contains(it->GetString())) {
-                        logger::info("removed '{}'", it->GetString());
-                        it = original.Erase(it);
-                    } else {
-                        ++it;
+            logger::error("Random slider chance must be a whole number between 0 and 100");
+            return -1;
+        }};
+        const auto readFloat{[](const rapidjson::Value& a_item, const char* a_key) {
+            const auto value{a_item.FindMember(a_key)};
+            return value != a_item.MemberEnd() && value->value.IsNumber() ? value->value.GetFloat() : 0.0f;
+        }};
+
+        for (const auto& item : a_entries.GetArray()) {
+            if (!item.IsObject()) continue;
+
+            if (const auto oneOf{item.FindMember("oneOf")}; oneOf != item.MemberEnd() && oneOf->value.IsArray()) {
+                a_tokens.push_back({Type::kOneOf});
+                for (const auto& option : oneOf->value.GetArray()) {
+                    if (!option.IsObject()) continue;
+
+                    a_tokens.push_back({Type::kOption, readChance(option)});
+                    if (const auto sliders{option.FindMember("sliders")};
+                        sliders != option.MemberEnd() && sliders->value.IsArray()) {
+                        ReadRandomSliderTokens(sliders->value, a_tokens);
                     }
                 }
+                a_tokens.push_back({Type::kEnd});
+                continue;
             }
-        }
 
-        logger::info(TitleFormatSpecifier, blacklistedNpcsPluginFemale->name.GetString());
-        if (AnyNotEnd(end, blacklistedNpcsPluginFemale)) {
-            auto& original = blacklistedNpcsPluginFemale->value;
-            stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-            for (auto it = original.Begin(); it != original.End();) {
-                if (!data_handler->LookupModByName(it->GetString())) {
-                    logger::info("removed '{}'", it->GetString());
-                    it = original.Erase(it);
-                } else {
-                    ++it;
-                }
+            const auto name{item.FindMember("name")};
+            if (name == item.MemberEnd() || !name->value.IsString()) continue;
+
+            PresetManager::RandomSliderToken token{Type::kSlider, readChance(item),
+                                                   {name->value.GetString(), name->value.GetStringLength()}};
+            if (item.HasMember("value")) {
+                token.min = token.max = readFloat(item, "value");
+            } else {
+                token.min = readFloat(item, "min");
+                token.max = readFloat(item, "max");
             }
+            a_tokens.push_back(token);
         }
+    }
 
-        logger::info(TitleFormatSpecifier, blacklistedNpcsPluginMale->name.GetString());
-        if (AnyNotEnd(end, blacklistedNpcsPluginMale)) {
-            auto& original = blacklistedNpcsPluginMale->value;
-            stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-            for (auto it = original.Begin(); it != original.End();) {
-                if (!data_handler->LookupModByName(it->GetString())) {
-                    logger::info("removed '{}'", it->GetString());
-                    it = original.Erase(it);
-                } else {
-                    ++it;
+    PresetManager::RandomSliderTable ReadRandomSliders(
+        const rapidjson::Document& a_config, const char* a_key,
+        const std::span<const PresetManager::RandomSliderToken> a_defaults) {
+        const auto config{a_config.FindMember("randomSliders")};
+        if (config != a_config.MemberEnd() && config->value.IsObject()) {
+            if (const auto itr{config->value.FindMember(a_key)};
+                itr != config->value.MemberEnd() && itr->value.IsArray()) {
+                std::vector<PresetManager::RandomSliderToken> tokens;
+                ReadRandomSliderTokens(itr->value, tokens);
+                if (auto table{PresetManager::RandomSliderTable::Compile(tokens)}) {
+                    logger::info("Using the {} random sliders from the config", a_key);
+                    return std::move(*table);
                 }
+                logger::error("Invalid {} random sliders, using the default ones", a_key);
             }
         }
 
-        logger::info(TitleFormatSpecifier, "blacklistedOutfitsFromORefit|outfitsForceRefit");
-        if (AnyNotEnd(end, blacklistedOutfitsFromORefit, outfitsForceRefit)) {
-            auto d = data_handler->GetFormArray<RE::TESObjectARMO>() |
-                     std::views::transform([](const RE::TESObjectARMO* outfit) { return outfit->GetName(); });
-            const std::set<std::string> d_set(d.begin(), d.end());
+        return *PresetManager::RandomSliderTable::Compile(a_defaults);
+    }
 
-            logger::info(TitleFormatSpecifier, blacklistedOutfitsFromORefit->name.GetString());
-            if (AnyNotEnd(end, blacklistedOutfitsFromORefit)) {
-                auto& original = blacklistedOutfitsFromORefit->value;
-                stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-                for (auto it = original.Begin(); it != original.End();) {
-                    if (!d_set.contains(it->GetString())) {
-                        logger::info("removed '{}'", it->GetString());
-                        it = original.Erase(it);
-                    } else {
-                        ++it;
-                    }
+    void JSONParser::CompileRules() {
+        [[maybe_unused]] stl::timeit const t;
+
+        npcRules = ReadPresetRules(presetDistributionConfig, "npc");
+        factionFemaleRules = ReadPresetRules(presetDistributionConfig, "factionFemale");
+        factionMaleRules = ReadPresetRules(presetDistributionConfig, "factionMale");
+        npcPluginFemaleRules = ReadPresetRules(presetDistributionConfig, "npcPluginFemale");
+        npcPluginMaleRules = ReadPresetRules(presetDistributionConfig, "npcPluginMale");
+        raceFemaleRules = ReadPresetRules(presetDistributionConfig, "raceFemale");
+        raceMaleRules = ReadPresetRules(presetDistributionConfig, "raceMale");
+
+        // Duplicate FormIDs keep their first entry, same as the linear scan this index replaces
+        characterCategoryIndex.reserve(characterCategorySet.size());
+        for (std::size_t i{}; i < characterCategorySet.size(); ++i) {
+            characterCategoryIndex.emplace(characterCategorySet[i].formID, static_cast<std::uint32_t>(i));
+        }
+
+        // Faction keys were checked against the loaded editor IDs by FilterOutNonLoaded, so they are resolved to
+        // forms once here and Resolve only has to look up the actor's faction FormIDs
+        const auto indexFactions{[](const std::vector<PresetRule>& a_rules, stl::id_map<std::uint32_t>& a_index) {
+            a_index.reserve(a_rules.size());
+            for (std::size_t i{}; i < a_rules.size(); ++i) {
+                if (const auto* const faction{RE::TESForm::LookupByEditorID<RE::TESFaction>(a_rules[i].key)}) {
+                    a_index.emplace(faction->GetFormID(), static_cast<std::uint32_t>(i));
                 }
             }
+        }};
+        indexFactions(factionFemaleRules, factionFemaleIndex);
+        indexFactions(factionMaleRules, factionMaleIndex);
 
-            logger::info(TitleFormatSpecifier, outfitsForceRefit->name.GetString());
-            if (AnyNotEnd(end, outfitsForceRefit)) {
-                auto& original = outfitsForceRefit->value;
-                stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-                for (auto it = original.Begin(); it != original.End();) {
-                    if (!d_set.contains(it->GetString())) {
-                        logger::info("removed '{}'", it->GetString());
-                        it = original.Erase(it);
-                    } else {
-                        ++it;
-                    }
+        // Plugins and races are matched by load order key and race FormID, so Resolve never compares strings
+        auto* const data_handler{RE::TESDataHandler::GetSingleton()};
+        const auto indexPlugins{[data_handler](const std::vector<PresetRule>& a_rules,
+                                               stl::id_map<std::uint32_t>& a_index) {
+            a_index.reserve(a_rules.size());
+            for (std::size_t i{}; i < a_rules.size(); ++i) {
+                if (const auto* const file{data_handler->LookupModByName(a_rules[i].key)}) {
+                    a_index.emplace(GetPluginKey(file), static_cast<std::uint32_t>(i));
                 }
             }
+        }};
+        indexPlugins(npcPluginFemaleRules, npcPluginFemaleIndex);
+        indexPlugins(npcPluginMaleRules, npcPluginMaleIndex);
+
+        std::unordered_map<std::string, std::uint32_t> races;
+        for (const auto* const race : data_handler->GetFormArray<RE::TESRace>()) {
+            races.emplace(stl::get_editorID(race->As<RE::TESForm>()), race->GetFormID());
         }
 
-        logger::info(TitleFormatSpecifier, blacklistedOutfitsFromORefitPlugin->name.GetString());
-        if (AnyNotEnd(end, blacklistedOutfitsFromORefitPlugin)) {
-            auto& original = blacklistedOutfitsFromORefitPlugin->value;
-            stl::RemoveDuplicatesInJsonArray(original, presetDistributionConfig.GetAllocator());
-            for (auto it = original.Begin(); it != original.End();) {
-                if (!data_handler->LookupModByName(it->GetString())) {
-                    logger::info("removed '{}'", it->GetString());
-                    it = original.Erase(it);
-                } else {
-                    ++it;
+        const auto indexRaces{[&races](const std::vector<PresetRule>& a_rules, stl::id_map<std::uint32_t>& a_index) {
+            a_index.reserve(a_rules.size());
+            for (std::size_t i{}; i < a_rules.size(); ++i) {
+                if (const auto race{races.find(a_rules[i].key)}; race != races.end()) {
+                    a_index.emplace(race->second, static_cast<std::uint32_t>(i));
                 }
             }
+        }};
+        indexRaces(raceFemaleRules, raceFemaleIndex);
+        indexRaces(raceMaleRules, raceMaleIndex);
+
+        presetRuleCount = 0;
+        for (auto& character : characterCategorySet) character.bodyslidePresets.slot = presetRuleCount++;
+        for (auto* const rules : {&npcRules, &factionFemaleRules, &factionMaleRules, &npcPluginFemaleRules,
+                                  &npcPluginMaleRules, &raceFemaleRules, &raceMaleRules}) {
+            for (auto& rule : *rules) rule.presets.slot = presetRuleCount++;
+        }
+
+        blacklistedNpcs = ReadStrings(presetDistributionConfig, "blacklistedNpcs");
+        blacklistedNpcsPluginFemale = ReadPluginKeys(presetDistributionConfig, "blacklistedNpcsPluginFemale");
+        blacklistedNpcsPluginMale = ReadPluginKeys(presetDistributionConfig, "blacklistedNpcsPluginMale");
+        blacklistedRacesFemale = ReadRaceIDs(presetDistributionConfig, "blacklistedRacesFemale", races);
+        blacklistedRacesMale = ReadRaceIDs(presetDistributionConfig, "blacklistedRacesMale", races);
+        blacklistedOutfitsFromORefit = ReadStrings(presetDistributionConfig, "blacklistedOutfitsFromORefit");
+        blacklistedOutfitsFromORefitPlugin =
+            ReadStrings(presetDistributionConfig, "blacklistedOutfitsFromORefitPlugin");
+        outfitsForceRefit = ReadStrings(presetDistributionConfig, "outfitsForceRefit");
+        blacklistedPresetsFromRandomDistribution =
+            ReadStrings(presetDistributionConfig, "blacklistedPresetsFromRandomDistribution");
+
+        if (const auto itr{presetDistributionConfig.FindMember("blacklistedPresetsShowInOBodyMenu")};
+            itr != presetDistributionConfig.MemberEnd() && itr->value.IsBool()) {
+            blacklistedPresetsShowInOBodyMenu = itr->value.GetBool();
+        } else {
+            logger::info(
+                "Failed to read blacklistedPresetsShowInOBodyMenu key. Defaulting to showing the blacklisted presets "
+                "in OBody menu.");
         }
+
+        if (const auto itr{presetDistributionConfig.FindMember("deterministicDistribution")};
+            itr != presetDistributionConfig.MemberEnd() && itr->value.IsBool()) {
+            deterministicDistribution = itr->value.GetBool();
+        }
+
+        if (const auto itr{presetDistributionConfig.FindMember("distributionSalt")};
+            itr != presetDistributionConfig.MemberEnd() && itr->value.IsUint64()) {
+            distributionSalt = itr->value.GetUint64();
+        }
+
+        randomNippleSliders =
+            ReadRandomSliders(presetDistributionConfig, "nipple", PresetManager::DefaultNippleSliders());
+        randomGenitalSliders =
+            ReadRandomSliders(presetDistributionConfig, "genital", PresetManager::DefaultGenitalSliders());
+
+        ClearDecisionCache();
+        logger::info("Compiled {} preset rules", presetRuleCount);
     }
 
-    void JSONParser::ProcessJSONCategories() {
-        [[maybe_unused]] stl::timeit const t;
-        logger::info(TitleFormatSpecifier, "Starting: Removing Not-Loaded Items");
-        ProcessNPCsFormIDBlacklist();
-        ProcessNPCsFormID();
-        ProcessOutfitsFormIDBlacklist();
-        ProcessOutfitsForceRefitFormIDBlacklist();
-        FilterOutNonLoaded();
-        logger::info(TitleFormatSpecifier, "Finished: Removing Not-Loaded Items");
-        rapidjson::StringBuffer buffer;
-        rapidjson::PrettyWriter writer(buffer);
-        presetDistributionConfig.Accept(writer);
+    void ResolveCandidates(PresetManager::PresetSnapshot& a_presets, const PresetCandidates& a_candidates,
+                           const std::string_view a_rule, const bool a_female, const bool a_male) {
+        if (a_female) {
+            a_presets.femaleCandidates[a_candidates.slot] =
+                PresetManager::ResolveCandidates(a_presets.allFemalePresets, a_candidates.names,
+                                                 a_candidates.weights);
+        }
+        if (a_male) {
+            a_presets.maleCandidates[a_candidates.slot] =
+                PresetManager::ResolveCandidates(a_presets.allMalePresets, a_candidates.names,
+                                                 a_candidates.weights);
+        }
 
-        logger::info("After Filtering: \n{}", buffer.GetString());
+        for (const auto& name : a_candidates.names) {
+            if ((!a_female || !a_presets.allFemalePresets.IndexOf(name)) &&
+                (!a_male || !a_presets.allMalePresets.IndexOf(name))) {
+                logger::info("Preset '{}' in '{}' doesn't exist, dropping it", name, a_rule);
+            }
+        }
     }
 
-    bool JSONParser::IsStringInJsonConfigKey(const std::string_view a_value, const char* key) {
-        const auto obj{presetDistributionConfig.FindMember(key)};
-        if (obj == presetDistributionConfig.MemberEnd()) {
-            return false;
+    void JSONParser::ResolvePresetRules(PresetManager::PresetSnapshot& a_presets) const {
+        [[maybe_unused]] stl::timeit const t;
+
+        a_presets.femaleCandidates.resize(presetRuleCount);
+        a_presets.maleCandidates.resize(presetRuleCount);
+
+        for (const auto& character : characterCategorySet) {
+            ResolveCandidates(a_presets, character.bodyslidePresets,
+                              std::format("npcFormID|{}|{:08X}", character.owningMod, character.formID), true, true);
         }
-        const auto& objValue = obj->value;
-        return std::find(objValue.Begin(), objValue.End(), a_value.data()) != objValue.End();
+
+        const auto resolve{[&a_presets](const std::vector<PresetRule>& a_rules, const std::string_view a_key,
+                                        const bool a_female, const bool a_male) {
+            for (const auto& rule : a_rules) {
+                ResolveCandidates(a_presets, rule.presets, std::format("{}|{}", a_key, rule.key), a_female, a_male);
+            }
+        }};
+
+        resolve(npcRules, "npc", true, true);
+        resolve(factionFemaleRules, "factionFemale", true, false);
+        resolve(factionMaleRules, "factionMale", false, true);
+        resolve(npcPluginFemaleRules, "npcPluginFemale", true, false);
+        resolve(npcPluginMaleRules, "npcPluginMale", false, true);
+        resolve(raceFemaleRules, "raceFemale", true, false);
+        resolve(raceMaleRules, "raceMale", false, true);
     }
 
-    // ReSharper disable once CppPassValueParameterByConstReference
-    bool JSONParser::IsSubKeyInJsonConfigKey(const char* key, const std::string_view subKey) {
-        const auto obj{presetDistributionConfig.FindMember(key)};
-        return obj != presetDistributionConfig.MemberEnd() && obj->value.HasMember(subKey.data());
+    const PresetRule* FindPresetRule(const std::vector<PresetRule>& a_rules, const std::string_view a_key) {
+        const auto it{std::ranges::find(a_rules, a_key, &PresetRule::key)};
+        return it != a_rules.end() ? &*it : nullptr;
     }
 
-    bool JSONParser::IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit) {
-        return IsStringInJsonConfigKey(a_outfit.GetName(), "blacklistedOutfitsFromORefit") ||
+    bool JSONParser::IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit) const {
+        return blacklistedOutfitsFromORefit.contains(a_outfit.GetName()) ||
                IsOutfitInBlacklistedOutfitCategorySet(a_outfit.GetFormID()) ||
-               IsStringInJsonConfigKey(GetNthFormLocationName(a_outfit.As<RE::TESForm>(), 0),
-                                       "blacklistedOutfitsFromORefitPlugin");
+               blacklistedOutfitsFromORefitPlugin.contains(GetNthFormLocationName(a_outfit.As<RE::TESForm>(), 0));
     }
 
     bool JSONParser::IsAnyForceRefitItemEquipped(RE::Actor* a_actor, const bool a_removingArmor,
-                                                 const RE::TESForm* a_equippedArmor) {
+                                                 const RE::TESForm* a_equippedArmor) const {
         auto inventory = a_actor->GetInventory() | std::views::transform([](const auto& pair) {
                              return std::pair<RE::TESBoundObject*, const std::unique_ptr<RE::InventoryEntryData>&>(
                                  pair.first, pair.second.second);  // Return the unique_ptr directly
@@ -589,7 +755,7 @@ namespace Parser {
 
                 if (const RE::FormType itemFormType = bound_obj->GetFormType();
                     (itemFormType == RE::FormType::Armor || itemFormType == RE::FormType::Armature) &&
-                        IsStringInJsonConfigKey(inventory_entry_data->GetDisplayName(), "outfitsForceRefit") ||
+                        outfitsForceRefit.contains(inventory_entry_data->GetDisplayName()) ||
                     IsOutfitInForceRefitCategorySet(bound_obj->GetFormID())) {
                     logger::info("Outfit {} is in force refit list", inventory_entry_data->GetDisplayName());
 
@@ -602,8 +768,8 @@ namespace Parser {
     }
 
     // ReSharper disable once CppPassValueParameterByConstReference
-    bool JSONParser::IsNPCBlacklisted(const std::string_view actorName, const uint32_t actorID) {
-        if (IsStringInJsonConfigKey(actorName.data(), "blacklistedNpcs")) {
+    bool JSONParser::IsNPCBlacklisted(const std::string_view actorName, const uint32_t actorID) const {
+        if (blacklistedNpcs.contains(actorName)) {
             logger::info("{} is Blacklisted by blacklistedNpcs", actorName);
             return true;
         }
@@ -616,124 +782,293 @@ namespace Parser {
         return false;
     }
 
-    bool JSONParser::IsNPCBlacklistedGlobally(const RE::Actor* a_actor, const char* actorRace, const bool female) {
-        const auto actorOwningMod{GetNthFormLocationName(a_actor, 0)};
-
-        if (female) {
-            return IsStringInJsonConfigKey(actorOwningMod, "blacklistedNpcsPluginFemale") ||
-                   IsStringInJsonConfigKey(actorRace, "blacklistedRacesFemale");
+    bool JSONParser::IsNPCBlacklistedGlobally(const ActorDescriptor& a_actor) const {
+        if (a_actor.female) {
+            return blacklistedNpcsPluginFemale.contains(a_actor.plugin) ||
+                   blacklistedRacesFemale.contains(a_actor.race);
         }
-        return IsStringInJsonConfigKey(actorOwningMod, "blacklistedNpcsPluginMale") ||
-               IsStringInJsonConfigKey(actorRace, "blacklistedRacesMale");
+        return blacklistedNpcsPluginMale.contains(a_actor.plugin) ||
+               blacklistedRacesMale.contains(a_actor.race);
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCFactionPreset(const RE::TESNPC* a_actor, const bool female) {
-        auto actorRanks{a_actor->factions | std::views::transform(&RE::FACTION_RANK::faction)};
+    ActorDescriptor DescribeActor(const RE::Actor* a_actor, const bool female) {
+        const auto* const actorBase{a_actor->GetActorBase()};
+
+        const auto* const race{actorBase->GetRace()};
 
-        const std::vector<RE::TESFaction*> actorFactions{actorRanks.begin(), actorRanks.end()};
+        ActorDescriptor ret{actorBase->GetName(), actorBase->GetFormID(), female, race ? race->GetFormID() : 0,
+                            GetOwningPluginKey(a_actor)};
 
-        if (actorFactions.empty()) {
-            return {};
+        if (GetHasSourceFileArray(actorBase)) {
+            RE::TESFile** sourceFiles{actorBase->sourceFiles.array->data()};
+            ret.basePlugins.reserve(actorBase->sourceFiles.array->size());
+            for (std::size_t i{}; i < actorBase->sourceFiles.array->size(); i++) {
+                ret.basePlugins.push_back(GetPluginKey(sourceFiles[i]));
+            }
         }
 
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-        const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                        : presetContainer.allMalePresets};
+        ret.factions.reserve(actorBase->factions.size());
+        for (const auto& rank : actorBase->factions) {
+            if (rank.faction) ret.factions.push_back(rank.faction->GetFormID());
+        }
 
-        auto& a_faction{presetDistributionConfig[female ? "factionFemale" : "factionMale"]};
+        return ret;
+    }
 
-        for (auto itr = a_faction.MemberBegin(); itr != a_faction.MemberEnd(); ++itr) {
-            auto& [key, value]{*itr};
-            if (std::ranges::find(actorFactions, RE::TESFaction::LookupByEditorID(key.GetString())) !=
-                actorFactions.end()) {
-                std::vector<std::string_view> copy_of_value{value.Size()};
-                for (const auto& item : value.GetArray()) {
-                    copy_of_value.emplace_back(item.GetString());
-                }
+    // The earliest rule in the config matching any of the keys, whatever order the keys are in
+    const PresetRule* FindFirstRule(const std::vector<PresetRule>& a_rules, const stl::id_map<std::uint32_t>& a_index,
+                                    const std::span<const std::uint32_t> a_keys) {
+        auto first{std::numeric_limits<std::uint32_t>::max()};
+        for (const auto key : a_keys) {
+            if (const auto* const rule{a_index.find(key)}) first = std::min(first, *rule);
+        }
+        return first != std::numeric_limits<std::uint32_t>::max() ? &a_rules[first] : nullptr;
+    }
+
+    // Times one stage of a decision into a trace and passes the stage's result through. Without a trace it does
+    // nothing, so untraced decisions only pay a null check per stage.
+    class StageTimer {
+    public:
+        StageTimer(DecisionTrace* a_trace, const std::string_view a_stage) : trace(a_trace), stage(a_stage) {
+            if (trace) start = std::chrono::steady_clock::now();
+        }
 
-                return PresetManager::GetRandomPresetByName(presetSet, copy_of_value, female);
+        template <class T>
+        T Done(T a_result) const {
+            if (trace) {
+                const auto elapsed{std::chrono::steady_clock::now() - start};
+                trace->stages.emplace_back(stage, std::chrono::nanoseconds{elapsed}.count(),
+                                           static_cast<bool>(a_result));
             }
+            return a_result;
         }
 
-        return {};
-    }
+    private:
+        DecisionTrace* trace;
+        std::string_view stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    RuleMatch JSONParser::Match(const ActorDescriptor& a_actor, DecisionTrace* a_trace) const {
+        const bool female{a_actor.female};
+
+        if (StageTimer{a_trace, "blacklistedNpcs"}.Done(IsNPCBlacklisted(a_actor.name, a_actor.formID))) {
+            return {RuleSource::kBlacklisted};
+        }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCPreset(const char* actorName, const uint32_t formID,
-                                                                  const bool female) {
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        if (const auto* const character{StageTimer{a_trace, "npcFormID"}.Done([&]() -> const categorizedList* {
+                const auto* const ret{GetNPCFromCategorySet(a_actor.formID)};
+                return ret && !ret->bodyslidePresets.names.empty() ? ret : nullptr;
+            }())}) {
+            return {RuleSource::kNPCFormID, character->bodyslidePresets.slot};
+        }
+
+        if (const auto* const rule{StageTimer{a_trace, "npc"}.Done(FindPresetRule(npcRules, a_actor.name))}) {
+            return {RuleSource::kNPC, rule->presets.slot};
+        }
 
-        const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                        : presetContainer.allMalePresets};
+        if (StageTimer{a_trace, "blacklistedPluginsAndRaces"}.Done(IsNPCBlacklistedGlobally(a_actor))) {
+            return {RuleSource::kBlacklisted};
+        }
 
-        const auto character{GetNPCFromCategorySet(formID)};
+        // The earliest faction and plugin rules in the config win, same as checking them one by one in order
+        if (const auto* const rule{StageTimer{a_trace, "faction"}.Done(
+                female ? FindFirstRule(factionFemaleRules, factionFemaleIndex, a_actor.factions)
+                       : FindFirstRule(factionMaleRules, factionMaleIndex, a_actor.factions))}) {
+            return {RuleSource::kFaction, rule->presets.slot};
+        }
 
-        std::vector<std::string_view> characterBodyslidePresets;
+        if (const auto* const rule{StageTimer{a_trace, "npcPlugin"}.Done(
+                female ? FindFirstRule(npcPluginFemaleRules, npcPluginFemaleIndex, a_actor.basePlugins)
+                       : FindFirstRule(npcPluginMaleRules, npcPluginMaleIndex, a_actor.basePlugins))}) {
+            return {RuleSource::kPlugin, rule->presets.slot};
+        }
 
-        if (character.has_value()) {
-            if (!character->bodyslidePresets.empty()) {
-                characterBodyslidePresets.insert_range(characterBodyslidePresets.end(), character->bodyslidePresets);
-                return PresetManager::GetRandomPresetByName(presetSet, characterBodyslidePresets, female);
-            }
+        if (const auto* const rule{StageTimer{a_trace, "race"}.Done(
+                female ? FindFirstRule(raceFemaleRules, raceFemaleIndex, std::span{&a_actor.race, 1})
+                       : FindFirstRule(raceMaleRules, raceMaleIndex, std::span{&a_actor.race, 1}))}) {
+            return {RuleSource::kRace, rule->presets.slot};
         }
-        if (const auto npcItr{presetDistributionConfig.FindMember("npc")};
-            npcItr != presetDistributionConfig.MemberEnd()) {
-            const auto npcActorItr{npcItr->value.FindMember(actorName)};
 
-            if (npcActorItr == npcItr->value.MemberEnd()) return {};
+        logger::info("No preset defined for this actor, getting it randomly");
+        return {RuleSource::kRandom};
+    }
+
+    // Everything Match looks at comes from the actor base except the plugin blacklists, which check the reference.
+    // Bases created at runtime (leveled and temporary ones, 0xFF FormIDs) get no key: the game hands their FormIDs out
+    // again to unrelated NPCs, and there is no end to how many it makes.
+    std::optional<std::uint64_t> GetDecisionKey(const std::uint32_t a_formID, const std::uint32_t a_plugin,
+                                                const bool a_female) {
+        if ((a_formID >> 24) == 0xFF) return std::nullopt;
+        return (std::uint64_t{a_plugin} << 33) | (std::uint64_t{a_female} << 32) | a_formID;
+    }
+
+    Decision Draw(const RuleMatch& a_match, const bool female, const PresetManager::PresetSnapshot& a_presets) {
+        switch (a_match.source) {
+            case RuleSource::kBlacklisted:
+                return {RuleSource::kBlacklisted};
+            case RuleSource::kRandom:
+                return {RuleSource::kRandom, PresetManager::GetRandomPreset(a_presets.GetPresets(female))};
+            default:
+                return {a_match.source, PresetManager::GetRandomPresetFromCandidates(a_presets, a_match.slot, female)};
+        }
+    }
 
-            characterBodyslidePresets.reserve(npcActorItr->value.Size());
-            for (const auto& item : npcActorItr->value.GetArray()) {
-                characterBodyslidePresets.emplace_back(item.GetString());
+    std::optional<RuleMatch> JSONParser::FindCachedMatch(const std::uint64_t a_key) const {
+        {
+            const std::scoped_lock lock{decisionCacheLock};
+            if (const auto it{decisionCache.find(a_key)}; it != decisionCache.end()) {
+                decisionCacheHits.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
             }
-            return PresetManager::GetRandomPresetByName(presetSet, characterBodyslidePresets, female);
         }
-        return {};
+
+        decisionCacheMisses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCPluginPreset(const RE::TESNPC* a_actor,
-                                                                        const char* actorName, const bool female) {
-        const char* keyForPreset{female ? "npcPluginFemale" : "npcPluginMale"};
+    void JSONParser::CacheMatch(const std::uint64_t a_key, const RuleMatch a_match) const {
+        const std::scoped_lock lock{decisionCacheLock};
+        decisionCache.emplace(a_key, a_match);
+    }
 
-        if (presetDistributionConfig.HasMember(keyForPreset)) {
-            auto& presets = presetDistributionConfig[keyForPreset];
-            for (auto itr = presets.MemberBegin(); itr != presets.MemberEnd(); ++itr) {
-                auto& [mod, presetList] = *itr;
-                logger::info("Checking if actor {} is in mod {}", actorName, mod.GetString());
+    Decision JSONParser::Resolve(const ActorDescriptor& a_actor, const PresetManager::PresetSnapshot& a_presets) const {
+        const auto key{GetDecisionKey(a_actor.formID, a_actor.plugin, a_actor.female)};
+        if (!key) return Draw(Match(a_actor), a_actor.female, a_presets);
 
-                if (IsActorInForm(a_actor, mod.GetString())) {
-                    const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+        auto match{FindCachedMatch(*key)};
+        if (!match) {
+            match = Match(a_actor);
+            CacheMatch(*key, *match);
+        }
 
-                    const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                                    : presetContainer.allMalePresets};
+        return Draw(*match, a_actor.female, a_presets);
+    }
 
-                    std::vector<std::string_view> presets_copy{presets[mod].Size()};
-                    for (const auto& item : presets[mod].GetArray()) {
-                        presets_copy.emplace_back(item.GetString());
-                    }
+    Decision JSONParser::Resolve(const RE::Actor* a_actor, const bool female,
+                                 const PresetManager::PresetSnapshot& a_presets) const {
+        const auto key{GetDecisionKey(a_actor->GetActorBase()->GetFormID(), GetOwningPluginKey(a_actor), female)};
+        if (!key) return Draw(Match(DescribeActor(a_actor, female)), female, a_presets);
 
-                    return GetRandomPresetByName(presetSet, presets_copy, female);
-                }
-            }
+        auto match{FindCachedMatch(*key)};
+        if (!match) {
+            match = Match(DescribeActor(a_actor, female));
+            CacheMatch(*key, *match);
         }
 
-        return {};
+        return Draw(*match, female, a_presets);
     }
 
-    std::optional<PresetManager::Preset> JSONParser::GetNPCRacePreset(const char* actorRace, const bool female) {
-        const char* key{female ? "raceFemale" : "raceMale"};
+    void JSONParser::ClearDecisionCache() const {
+        const std::scoped_lock lock{decisionCacheLock};
+        logger::info("Clearing {} cached distribution decisions after {} hits and {} misses", decisionCache.size(),
+                     decisionCacheHits.exchange(0), decisionCacheMisses.exchange(0));
+        decisionCache.clear();
+    }
+
+    std::uint64_t JSONParser::GetDistributionSeed(const RE::Actor* a_actor) const {
+        return (std::uint64_t{a_actor->GetFormID()} << 32) ^ distributionSalt;
+    }
 
-        if (IsSubKeyInJsonConfigKey(key, actorRace)) {
-            const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
+    DecisionTrace JSONParser::Trace(const RE::Actor* a_actor, const bool female,
+                                    const PresetManager::PresetSnapshot& a_presets) const {
+        const auto start{std::chrono::steady_clock::now()};
 
-            const PresetManager::PresetSet presetSet{female ? presetContainer.allFemalePresets
-                                                            : presetContainer.allMalePresets};
-            std::vector<std::string_view> presets_copy{presetDistributionConfig[key][actorRace].Size()};
-            for (const auto& item : presetDistributionConfig[key][actorRace].GetArray()) {
-                presets_copy.emplace_back(item.GetString());
-            }
-            return PresetManager::GetRandomPresetByName(presetSet, presets_copy, female);
+        // Seeded like GenerateActorBody, so the traced draw is the one the actor gets
+        std::optional<stl::deterministic_random> seed;
+        if (deterministicDistribution) seed.emplace(GetDistributionSeed(a_actor));
+
+        DecisionTrace ret;
+        ret.female = female;
+
+        const StageTimer describe{&ret, "describe"};
+        const auto actor{DescribeActor(a_actor, female)};
+        describe.Done(true);
+        ret.formID = actor.formID;
+        ret.name = actor.name;
+
+        {
+            const std::scoped_lock lock{decisionCacheLock};
+            const auto key{GetDecisionKey(actor.formID, actor.plugin, female)};
+            ret.cached = key && decisionCache.contains(*key);
+        }
+
+        ret.match = Match(actor, &ret);
+
+        if (ret.match.source == RuleSource::kRandom) {
+            ret.candidates = a_presets.GetPresets(female).size();
+        } else if (ret.match.source != RuleSource::kBlacklisted) {
+            ret.candidates = a_presets.GetCandidates(ret.match.slot, female).size();
+        }
+
+        if (const auto* const preset{StageTimer{&ret, "draw"}.Done(Draw(ret.match, female, a_presets).preset)}) {
+            ret.preset = preset->name;
+        }
+
+        ret.totalNanoseconds = std::chrono::nanoseconds{std::chrono::steady_clock::now() - start}.count();
+        return ret;
+    }
+
+    std::string_view ToString(const RuleSource a_source) {
+        switch (a_source) {
+            case RuleSource::kBlacklisted:
+                return "blacklisted";
+            case RuleSource::kNPCFormID:
+                return "npcFormID";
+            case RuleSource::kNPC:
+                return "npc";
+            case RuleSource::kFaction:
+                return "faction";
+            case RuleSource::kPlugin:
+                return "npcPlugin";
+            case RuleSource::kRace:
+                return "race";
+            default:
+                return "random";
+        }
+    }
+
+    std::string ToJSON(const DecisionTrace& a_trace) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer writer(buffer);
+
+        const auto writeString{[&writer](const std::string_view a_str) {
+            writer.String(a_str.data(), static_cast<rapidjson::SizeType>(a_str.size()));
+        }};
+
+        writer.StartObject();
+        writer.Key("formID");
+        writeString(std::format("{:08X}", a_trace.formID));
+        writer.Key("name");
+        writeString(a_trace.name);
+        writer.Key("female");
+        writer.Bool(a_trace.female);
+        writer.Key("cached");
+        writer.Bool(a_trace.cached);
+        writer.Key("rule");
+        writeString(ToString(a_trace.match.source));
+        writer.Key("candidates");
+        writer.Uint64(a_trace.candidates);
+        writer.Key("preset");
+        writeString(a_trace.preset);
+        writer.Key("totalNanoseconds");
+        writer.Int64(a_trace.totalNanoseconds);
+
+        writer.Key("stages");
+        writer.StartArray();
+        for (const auto& stage : a_trace.stages) {
+            writer.StartObject();
+            writer.Key("name");
+            writeString(stage.name);
+            writer.Key("matched");
+            writer.Bool(stage.matched);
+            writer.Key("nanoseconds");
+            writer.Int64(stage.nanoseconds);
+            writer.EndObject();
         }
+        writer.EndArray();
+        writer.EndObject();
 
-        return {};
+        return buffer.GetString();
     }
-}  // namespace Parser
\ No newline at end of file
+}  // namespace Parser
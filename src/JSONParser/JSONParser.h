@@ -1,14 +1,84 @@
 #pragma once
 
-#include "PresetManager/PresetManager.h"
+#include "PresetManager/RandomSliders.h"
 
 namespace Parser {
+    // Preset names from one config entry. The slot says where the entry's resolved candidates live in every
+    // PresetSnapshot, so they can be resolved again whenever the presets are reloaded.
+    struct PresetCandidates {
+        std::vector<std::string> names;
+        std::vector<float> weights;  // one per name, empty when the entry has no weighted presets
+        std::uint32_t slot{};
+    };
+
     struct categorizedList {
         std::string owningMod;
         uint32_t formID = 0;
-        std::vector<std::string> bodyslidePresets;
+        PresetCandidates bodyslidePresets;
+    };
+
+    // One key of an object-valued config entry such as npc, factionFemale or raceMale, in config order
+    struct PresetRule {
+        std::string key;
+        PresetCandidates presets;
+    };
+
+    // Everything the distribution rules look at, gathered once per actor so Resolve neither walks game objects nor
+    // builds strings. DescribeActor fills it from the game; synthetic descriptors work just as well. Plugins are
+    // identified by their load order key (see GetPluginKey).
+    struct ActorDescriptor {
+        std::string_view name;
+        uint32_t formID{};  // of the actor base
+        bool female{};
+        uint32_t race{};                    // FormID of the actor base's race
+        uint32_t plugin{};                  // file that first defines the actor reference
+        std::vector<uint32_t> basePlugins;  // every file that touches the actor base
+        std::vector<uint32_t> factions;     // FormIDs of the actor base's factions
+    };
+
+    // Load order position of a plugin, unique across full and light plugins and never 0
+    uint32_t GetPluginKey(const RE::TESFile* a_file);
+
+    ActorDescriptor DescribeActor(const RE::Actor* a_actor, bool female);
+
+    // Rules in the order Resolve tries them
+    enum class RuleSource : std::uint8_t { kBlacklisted, kNPCFormID, kNPC, kFaction, kPlugin, kRace, kRandom };
+
+    // What the rules decided for an actor before the random draw. Only depends on the config, so it can be reused
+    // for every actor the rules can't tell apart.
+    struct RuleMatch {
+        RuleSource source{RuleSource::kRandom};
+        std::uint32_t slot{};  // candidate slot of the matched rule; unused when blacklisted or random
+    };
+
+    struct Decision {
+        RuleSource source{RuleSource::kRandom};
+        const PresetManager::Preset* preset{};  // nullptr when blacklisted or when there are no presets at all
     };
 
+    // Step by step record of one decision, for finding out why an actor got the body it got. Only Trace fills one in;
+    // the normal distribution path doesn't collect anything.
+    struct DecisionTrace {
+        struct Stage {
+            std::string_view name;
+            std::int64_t nanoseconds{};
+            bool matched{};
+        };
+
+        std::uint32_t formID{};
+        std::string name;
+        bool female{};
+        bool cached{};  // whether distribution would have reused a cached match instead of running the stages
+        std::vector<Stage> stages;
+        RuleMatch match;
+        std::size_t candidates{};
+        std::string preset;
+        std::int64_t totalNanoseconds{};
+    };
+
+    std::string_view ToString(RuleSource a_source);
+    std::string ToJSON(const DecisionTrace& a_trace);
+
     class JSONParser {
     public:
         JSONParser(JSONParser&&) = delete;
@@ -19,46 +89,103 @@ namespace Parser {
 
         static JSONParser& GetInstance();
 
-        void ProcessNPCsFormID();
-        void ProcessNPCsFormIDBlacklist();
-        void ProcessOutfitsFormIDBlacklist();
-        void ProcessOutfitsForceRefitFormIDBlacklist();
+        // Resolves npcFormID, blacklistedNpcsFormID, blacklistedOutfitsFromORefitFormID and outfitsForceRefitFormID
+        void ProcessFormIDs();
         void FilterOutNonLoaded();
 
         void ProcessJSONCategories();
+        void CompileRules();
+        void ResolvePresetRules(PresetManager::PresetSnapshot& a_presets) const;
 
-        [[nodiscard]] bool IsActorInBlacklistedCharacterCategorySet(uint32_t formID) const;
-        bool IsOutfitInBlacklistedOutfitCategorySet(uint32_t formID);
-        [[nodiscard]] bool IsOutfitInForceRefitCategorySet(uint32_t formID) const;
+        // Runs the compiled rules for one actor. The name and FormID blacklists come first, then npcFormID and npc,
+        // the plugin and race blacklists, the faction, plugin and race rules, and finally a random preset.
+        // a_trace, if given, gets every stage that ran.
+        [[nodiscard]] RuleMatch Match(const ActorDescriptor& a_actor, DecisionTrace* a_trace = nullptr) const;
 
-        [[nodiscard]] std::optional<categorizedList> GetNPCFromCategorySet(uint32_t formID) const;
-        bool IsStringInJsonConfigKey(std::string_view a_value, const char* key);
-        bool IsSubKeyInJsonConfigKey(const char* key, std::string_view subKey);
+        // Match, memoized per actor base, sex and plugin of the reference, followed by the random draw. Bases created
+        // at runtime aren't memoized. The actor overload only describes the actor when its match isn't cached yet.
+        [[nodiscard]] Decision Resolve(const ActorDescriptor& a_actor,
+                                       const PresetManager::PresetSnapshot& a_presets) const;
+        [[nodiscard]] Decision Resolve(const RE::Actor* a_actor, bool female,
+                                       const PresetManager::PresetSnapshot& a_presets) const;
 
-        bool IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit);
-        bool IsAnyForceRefitItemEquipped(RE::Actor* a_actor, bool a_removingArmor, const RE::TESForm* a_equippedArmor);
-        bool IsNPCBlacklisted(std::string_view actorName, uint32_t actorID);
-        bool IsNPCBlacklistedGlobally(const RE::Actor* a_actor, const char* actorRace, bool female);
+        // Seed of every draw for the actor when deterministicDistribution is on
+        [[nodiscard]] std::uint64_t GetDistributionSeed(const RE::Actor* a_actor) const;
 
-        std::optional<PresetManager::Preset> GetNPCFactionPreset(const RE::TESNPC* a_actor, bool female);
+        // Same decision as Resolve, without the cache, recording every stage and its timing
+        [[nodiscard]] DecisionTrace Trace(const RE::Actor* a_actor, bool female,
+                                          const PresetManager::PresetSnapshot& a_presets) const;
 
-        std::optional<PresetManager::Preset> GetNPCPreset(const char* actorName, uint32_t formID, bool female);
-        std::optional<PresetManager::Preset> GetNPCPluginPreset(const RE::TESNPC* a_actor, const char* actorName,
-                                                                bool female);
-        std::optional<PresetManager::Preset> GetNPCRacePreset(const char* actorRace, bool female);
+        // Called whenever the config or the presets are reloaded, and before a save is loaded. Logs how often the
+        // cache was hit since it was last cleared, i.e. once per play session.
+        void ClearDecisionCache() const;
 
+        [[nodiscard]] bool IsActorInBlacklistedCharacterCategorySet(uint32_t formID) const;
+        [[nodiscard]] bool IsOutfitInBlacklistedOutfitCategorySet(uint32_t formID) const;
+        [[nodiscard]] bool IsOutfitInForceRefitCategorySet(uint32_t formID) const;
+
+        [[nodiscard]] const categorizedList* GetNPCFromCategorySet(uint32_t formID) const;
+
+        [[nodiscard]] bool IsOutfitBlacklisted(const RE::TESObjectARMO& a_outfit) const;
+        bool IsAnyForceRefitItemEquipped(RE::Actor* a_actor, bool a_removingArmor,
+                                         const RE::TESForm* a_equippedArmor) const;
+        [[nodiscard]] bool IsNPCBlacklisted(std::string_view actorName, uint32_t actorID) const;
+        [[nodiscard]] bool IsNPCBlacklistedGlobally(const ActorDescriptor& a_actor) const;
+
+        // Only valid until ProcessJSONCategories has compiled it into the tables below
         rapidjson::Document presetDistributionConfig;
         bool bodyslidePresetsParsingValid{};
-        std::size_t invalid_presets{};
+        std::atomic<std::size_t> invalid_presets{};  // files the last preset load couldn't parse
 
-        std::vector<categorizedList> blacklistedCharacterCategorySet;
+        stl::id_set blacklistedCharacterCategorySet;
         std::vector<categorizedList> characterCategorySet;
-
-        std::vector<categorizedList> blacklistedOutfitCategorySet;
-        std::vector<categorizedList> forceRefitOutfitCategorySet;
+        stl::id_map<std::uint32_t> characterCategoryIndex;  // FormID to position in characterCategorySet
+
+        stl::id_set blacklistedOutfitCategorySet;
+        stl::id_set forceRefitOutfitCategorySet;
+
+        std::vector<PresetRule> npcRules;
+        std::vector<PresetRule> factionFemaleRules;
+        std::vector<PresetRule> factionMaleRules;
+        stl::id_map<std::uint32_t> factionFemaleIndex;  // faction FormID to position in factionFemaleRules
+        stl::id_map<std::uint32_t> factionMaleIndex;    // faction FormID to position in factionMaleRules
+        std::vector<PresetRule> npcPluginFemaleRules;
+        std::vector<PresetRule> npcPluginMaleRules;
+        stl::id_map<std::uint32_t> npcPluginFemaleIndex;  // plugin key to position in npcPluginFemaleRules
+        stl::id_map<std::uint32_t> npcPluginMaleIndex;    // plugin key to position in npcPluginMaleRules
+        std::vector<PresetRule> raceFemaleRules;
+        std::vector<PresetRule> raceMaleRules;
+        stl::id_map<std::uint32_t> raceFemaleIndex;  // race FormID to position in raceFemaleRules
+        stl::id_map<std::uint32_t> raceMaleIndex;    // race FormID to position in raceMaleRules
+        std::uint32_t presetRuleCount{};
+
+        stl::string_set blacklistedNpcs;
+        stl::id_set blacklistedNpcsPluginFemale;  // plugin keys
+        stl::id_set blacklistedNpcsPluginMale;
+        stl::id_set blacklistedRacesFemale;  // race FormIDs
+        stl::id_set blacklistedRacesMale;
+        stl::string_set blacklistedOutfitsFromORefit;
+        stl::string_set blacklistedOutfitsFromORefitPlugin;
+        stl::string_set outfitsForceRefit;
+        stl::string_set blacklistedPresetsFromRandomDistribution;
+        bool blacklistedPresetsShowInOBodyMenu{};
+        bool deterministicDistribution{};
+        std::uint64_t distributionSalt{};
+
+        // From randomSliders, or the defaults for whatever it doesn't override
+        PresetManager::RandomSliderTable randomNippleSliders;
+        PresetManager::RandomSliderTable randomGenitalSliders;
 
     private:
         JSONParser() = default;
         static JSONParser instance;
+
+        [[nodiscard]] std::optional<RuleMatch> FindCachedMatch(std::uint64_t a_key) const;
+        void CacheMatch(std::uint64_t a_key, RuleMatch a_match) const;
+
+        mutable std::mutex decisionCacheLock;
+        mutable std::unordered_map<std::uint64_t, RuleMatch> decisionCache;
+        mutable std::atomic_size_t decisionCacheHits;
+        mutable std::atomic_size_t decisionCacheMisses;
     };
 }  // namespace Parser
@@ -7,6 +7,15 @@
 #include <unordered_set>
 #include <ranges>
 #include <filesystem>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <functional>
+#include <shared_mutex>
+#include <deque>
+#include <span>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
@@ -22,6 +31,7 @@
 #include <pugixml.hpp>
 #include <random>
 #include <boost/algorithm/string.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
 
 namespace logger = SKSE::log;
 namespace fs = std::filesystem;
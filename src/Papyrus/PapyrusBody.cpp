@@ -35,11 +35,16 @@ namespace PapyrusBody {
     }
 
     int GetFemaleDatabaseSize(RE::StaticFunctionTag*) {
-        return static_cast<int>(PresetManager::PresetContainer::GetInstance().femalePresets.size());
+        return static_cast<int>(PresetManager::PresetContainer::GetInstance().Get()->femalePresets.size());
     }
 
     int GetMaleDatabaseSize(RE::StaticFunctionTag*) {
-        return static_cast<int>(PresetManager::PresetContainer::GetInstance().malePresets.size());
+        return static_cast<int>(PresetManager::PresetContainer::GetInstance().Get()->malePresets.size());
+    }
+
+    void ReloadPresets(RE::StaticFunctionTag*) {
+        // Parsing happens off the Papyrus thread; actors keep using the current presets until the new ones are ready
+        PresetManager::ReloadPresetsInBackground();
     }
 
     void RegisterForOBodyEvent(RE::StaticFunctionTag*, const RE::TESQuest* a_quest) {
@@ -62,8 +67,7 @@ namespace PapyrusBody {
 
     void AddClothesOverlay(RE::StaticFunctionTag*, RE::Actor* a_actor) {
         const auto& obody{Body::OBody::GetInstance()};
-        obody.ApplyClothePreset(a_actor);
-        obody.ApplyMorphs(a_actor, true);
+        if (obody.ApplyClothePreset(a_actor)) obody.ApplyMorphs(a_actor, true);
     }
 
     void ResetActorOBodyMorphs(RE::StaticFunctionTag*, RE::Actor* a_actor) {
@@ -75,27 +79,13 @@ namespace PapyrusBody {
     }
 
     std::vector<std::string> GetAllPossiblePresets(RE::StaticFunctionTag*, RE::Actor* a_actor) {
-        const auto& presetContainer{PresetManager::PresetContainer::GetInstance()};
-
-        const auto& presetDistributionConfig{Parser::JSONParser::GetInstance().presetDistributionConfig};
-        const auto showBlacklistedPresetsItr{presetDistributionConfig.FindMember("blacklistedPresetsShowInOBodyMenu")};
-        const auto end{presetDistributionConfig.MemberEnd()};
+        const auto presets{PresetManager::PresetContainer::GetInstance().Get()};
 
-        // Default to showing blacklisted presets if the key is missing or invalid
-        bool showBlacklistedPresets{false};
-
-        if (showBlacklistedPresetsItr != end && showBlacklistedPresetsItr->value.IsBool()) {
-            showBlacklistedPresets = showBlacklistedPresetsItr->value.GetBool();
-        } else {
-            logger::info(
-                "Failed to read blacklistedPresetsShowInOBodyMenu key. Defaulting to showing the blacklisted presets "
-                "in OBody menu.");
-        }
+        const bool showBlacklistedPresets{Parser::JSONParser::GetInstance().blacklistedPresetsShowInOBodyMenu};
 
+        const bool female{Body::OBody::IsFemale(a_actor)};
         auto presets_to_show =
-            (Body::OBody::IsFemale(a_actor)
-                 ? (showBlacklistedPresets ? presetContainer.allFemalePresets : presetContainer.femalePresets)
-                 : (showBlacklistedPresets ? presetContainer.allMalePresets : presetContainer.malePresets)) |
+            (showBlacklistedPresets ? presets->GetAllPresets(female) : presets->GetPresets(female)) |
             std::views::transform(&PresetManager::Preset::name);
 
         std::vector ret(presets_to_show.begin(), presets_to_show.end());
@@ -104,6 +94,18 @@ namespace PapyrusBody {
         return ret;
     }
 
+    std::string GetDistributionTrace(RE::StaticFunctionTag*, RE::Actor* a_actor) {
+        if (!a_actor) return {};
+
+        // Dry run: the actor's body isn't touched, only the decision OBody would make for it is recorded
+        const auto presets{PresetManager::PresetContainer::GetInstance().Get()};
+        const auto trace{Parser::JSONParser::GetInstance().Trace(a_actor, Body::OBody::IsFemale(a_actor), *presets)};
+
+        auto ret{Parser::ToJSON(trace)};
+        logger::info("Distribution trace for {}: {}", trace.name, ret);
+        return ret;
+    }
+
     bool Bind(VM* a_vm) {
         constexpr auto obj = "OBodyNative"sv;
 
@@ -112,12 +114,14 @@ namespace PapyrusBody {
         OBODY_PAPYRUS_BIND(GenActor);
         OBODY_PAPYRUS_BIND(ApplyPresetByName);
         OBODY_PAPYRUS_BIND(GetAllPossiblePresets);
+        OBODY_PAPYRUS_BIND(GetDistributionTrace);
         OBODY_PAPYRUS_BIND(AddClothesOverlay);
         OBODY_PAPYRUS_BIND(RegisterForOBodyEvent);
         OBODY_PAPYRUS_BIND(RegisterForOBodyNakedEvent);
         OBODY_PAPYRUS_BIND(RegisterForOBodyRemovingClothesEvent);
         OBODY_PAPYRUS_BIND(GetFemaleDatabaseSize);
         OBODY_PAPYRUS_BIND(GetMaleDatabaseSize);
+        OBODY_PAPYRUS_BIND(ReloadPresets);
         OBODY_PAPYRUS_BIND(ResetActorOBodyMorphs);
 
         OBODY_PAPYRUS_BIND(SetORefit);
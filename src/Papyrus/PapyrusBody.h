@@ -21,6 +21,8 @@ namespace PapyrusBody {
 
     int GetMaleDatabaseSize(RE::StaticFunctionTag*);
 
+    void ReloadPresets(RE::StaticFunctionTag*);
+
     void RegisterForOBodyEvent(RE::StaticFunctionTag*, const RE::TESQuest* a_quest);
 
     void RegisterForOBodyNakedEvent(RE::StaticFunctionTag*, const RE::TESQuest* a_quest);
@@ -35,5 +37,7 @@ namespace PapyrusBody {
 
     std::vector<std::string> GetAllPossiblePresets(RE::StaticFunctionTag*, RE::Actor* a_actor);
 
+    std::string GetDistributionTrace(RE::StaticFunctionTag*, RE::Actor* a_actor);
+
     bool Bind(VM* a_vm);
 }  // namespace PapyrusBody
@@ -0,0 +1,105 @@
+#include "PresetManager/NameTraits.h"
+
+namespace PresetManager {
+    namespace {
+        enum NameGroup : std::uint8_t { kClothed = 1 << 0, kMale = 1 << 1, kUNP = 1 << 2 };
+
+        struct NameKeyword {
+            std::string_view text;
+            std::uint8_t group;
+        };
+
+        constexpr std::array NameKeywords{
+            NameKeyword{"cloth", kClothed}, NameKeyword{"outfit", kClothed},   NameKeyword{"nevernude", kClothed},
+            NameKeyword{"bikini", kClothed}, NameKeyword{"feet", kClothed},    NameKeyword{"hands", kClothed},
+            NameKeyword{"push", kClothed},  NameKeyword{"cleavage", kClothed}, NameKeyword{"armor", kClothed},
+            NameKeyword{"himbo", kMale},    NameKeyword{"talos", kMale},       NameKeyword{"sam", kMale},
+            NameKeyword{"sos", kMale},      NameKeyword{"savren", kMale},      NameKeyword{"unp", kUNP},
+            NameKeyword{"coco", kUNP},      NameKeyword{"bhunp", kUNP},        NameKeyword{"uunp", kUNP}};
+
+        constexpr std::size_t NameAlphabet{26};
+        constexpr std::size_t NameStates{[] {
+            std::size_t ret{1};
+            for (const auto& keyword : NameKeywords) ret += keyword.text.size();
+            return ret;
+        }()};
+        static_assert(NameStates <= std::numeric_limits<std::uint8_t>::max());
+
+        // Aho-Corasick automaton over the lowercase keywords, with the failure links folded into a full transition
+        // table. groups[state] holds every keyword group that ends at that state, including through suffixes.
+        struct NameAutomaton {
+            std::array<std::array<std::uint8_t, NameAlphabet>, NameStates> next{};
+            std::array<std::uint8_t, NameStates> groups{};
+        };
+
+        constexpr NameAutomaton BuildNameAutomaton() {
+            NameAutomaton ret;
+
+            // Trie of the keywords. State 0 is the root, which is never a child, so 0 also means "no edge".
+            std::array<std::array<std::uint8_t, NameAlphabet>, NameStates> trie{};
+            std::size_t states{1};
+            for (const auto& [text, group] : NameKeywords) {
+                std::uint8_t state{};
+                for (const char c : text) {
+                    auto& child{trie[state][c - 'a']};
+                    if (child == 0) child = static_cast<std::uint8_t>(states++);
+                    state = child;
+                }
+                ret.groups[state] |= group;
+            }
+
+            // Breadth-first, so a state's failure link is always finished before the state itself
+            std::array<std::uint8_t, NameStates> fail{};
+            std::array<std::uint8_t, NameStates> queue{};
+            std::size_t head{}, tail{};
+            for (std::size_t c{}; c < NameAlphabet; ++c) {
+                ret.next[0][c] = trie[0][c];
+                if (trie[0][c] != 0) queue[tail++] = trie[0][c];
+            }
+            while (head < tail) {
+                const auto state{queue[head++]};
+                ret.groups[state] |= ret.groups[fail[state]];
+                for (std::size_t c{}; c < NameAlphabet; ++c) {
+                    if (const auto child{trie[state][c]}; child != 0) {
+                        fail[child] = ret.next[fail[state]][c];
+                        ret.next[state][c] = child;
+                        queue[tail++] = child;
+                    } else {
+                        ret.next[state][c] = ret.next[fail[state]][c];
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        constexpr NameAutomaton NameMatcher{BuildNameAutomaton()};
+
+        // Keywords are plain ASCII letters, so any other character can't be part of a match and sends the automaton
+        // back to the root. That folds case the same way the icontains loops this replaces did for these keywords.
+        template <class CharT>
+        NameTraits Classify(const std::basic_string_view<CharT> a_name) {
+            std::uint8_t state{}, groups{};
+            for (const CharT c : a_name) {
+                if (c >= 'a' && c <= 'z') {
+                    state = NameMatcher.next[state][c - 'a'];
+                } else if (c >= 'A' && c <= 'Z') {
+                    state = NameMatcher.next[state][c - 'A'];
+                } else {
+                    state = 0;
+                }
+                groups |= NameMatcher.groups[state];
+            }
+
+            return {(groups & kClothed) != 0, (groups & kMale) != 0, (groups & kUNP) != 0};
+        }
+    }  // namespace
+
+    NameTraits ClassifyName(const std::string_view a_name) { return Classify(a_name); }
+
+    NameTraits ClassifyName(const std::wstring_view a_name) { return Classify(a_name); }
+
+    bool IsClothedSet(const std::string_view a_set) { return ClassifyName(a_set).clothed; }
+
+    bool IsClothedSet(const std::wstring_view a_set) { return ClassifyName(a_set).clothed; }
+}  // namespace PresetManager
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace PresetManager {
+    // Which keyword groups occur in a preset, body or file name, case-insensitively
+    struct NameTraits {
+        bool clothed{};  // cloth, outfit, nevernude, ...: not a naked body preset
+        bool male{};     // himbo, talos, sam, sos, savren: made for a male body
+        bool unp{};      // unp, coco, bhunp, uunp: made for a UNP-family body
+    };
+
+    // Classifies a name against every keyword group in a single pass over its characters
+    NameTraits ClassifyName(std::string_view a_name);
+    NameTraits ClassifyName(std::wstring_view a_name);
+
+    bool IsClothedSet(std::string_view a_set);
+    bool IsClothedSet(std::wstring_view a_set);
+}  // namespace PresetManager
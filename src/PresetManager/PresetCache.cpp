@@ -0,0 +1,241 @@
+#include "PresetManager/PresetCache.h"
+
+#include "STL.h"
+
+namespace PresetManager {
+    namespace {
+        struct Header {
+            std::uint32_t magic{};
+            std::uint32_t version{};
+            std::uint32_t count{};
+            std::uint32_t reserved{};
+            std::uint64_t payloadSize{};
+            std::uint64_t checksum{};
+        };
+
+        std::uint64_t Checksum(const std::span<const char> a_data) {
+            // FNV-1a, 64-bit
+            std::uint64_t hash{0xcbf29ce484222325ull};
+            for (const char c : a_data) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        void Write(std::vector<char>& a_out, const T& a_value) {
+            const auto* const bytes{reinterpret_cast<const char*>(&a_value)};
+            a_out.insert(a_out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <class CharT>
+        void WriteString(std::vector<char>& a_out, const std::basic_string_view<CharT> a_str) {
+            Write(a_out, static_cast<std::uint32_t>(a_str.size()));
+            const auto* const bytes{reinterpret_cast<const char*>(a_str.data())};
+            a_out.insert(a_out.end(), bytes, bytes + (a_str.size() * sizeof(CharT)));
+        }
+
+        // Bounds-checked cursor over the cache bytes. Every read fails instead of running past the end, so a truncated
+        // or damaged cache is rejected rather than crashing the game.
+        class Reader {
+        public:
+            explicit Reader(const std::span<const char> a_data) : data(a_data) {}
+
+            template <class T>
+                requires std::is_trivially_copyable_v<T>
+            bool Read(T& a_value) {
+                if (data.size() < sizeof(T)) return false;
+                std::memcpy(&a_value, data.data(), sizeof(T));
+                data = data.subspan(sizeof(T));
+                return true;
+            }
+
+            template <class CharT>
+            bool ReadString(std::basic_string<CharT>& a_str) {
+                std::uint32_t length{};
+                if (!Read(length) || data.size() / sizeof(CharT) < length) return false;
+                a_str.resize(length);
+                std::memcpy(a_str.data(), data.data(), length * sizeof(CharT));
+                data = data.subspan(length * sizeof(CharT));
+                return true;
+            }
+
+            bool Skip(const std::size_t a_length) {
+                if (data.size() < a_length) return false;
+                data = data.subspan(a_length);
+                return true;
+            }
+
+            [[nodiscard]] const char* position() const { return data.data(); }
+            [[nodiscard]] bool empty() const { return data.empty(); }
+
+        private:
+            std::span<const char> data;
+        };
+    }  // namespace
+
+    PresetCache::Fingerprint PresetCache::GetFingerprint(const fs::directory_entry& a_entry) {
+        std::error_code ec;
+        const auto size{a_entry.file_size(ec)};
+        if (ec) return {};
+        const auto lastWriteTime{a_entry.last_write_time(ec)};
+        if (ec) return {};
+
+        return {size, static_cast<std::int64_t>(lastWriteTime.time_since_epoch().count())};
+    }
+
+    bool PresetCache::Load(const fs::path& a_path) {
+        buffer.clear();
+        entries.clear();
+
+        std::error_code ec;
+        const auto fileSize{fs::file_size(a_path, ec)};
+        if (ec) {
+            logger::info("No preset cache found, parsing every preset file");
+            return false;
+        }
+
+        {
+            std::ifstream file{a_path, std::ios::binary};
+            buffer.resize(fileSize);
+            if (!file || !file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                logger::warn("Failed to read the preset cache, parsing every preset file");
+                buffer.clear();
+                return false;
+            }
+        }
+
+        Reader reader{buffer};
+        Header header;
+        if (!reader.Read(header) || header.magic != Magic || header.version != Version) {
+            logger::info("Preset cache is from a different version, parsing every preset file");
+            buffer.clear();
+            return false;
+        }
+
+        const std::span payload{reader.position(), buffer.size() - sizeof(Header)};
+        if (header.payloadSize != payload.size() || header.checksum != Checksum(payload)) {
+            logger::warn("Preset cache is corrupt, parsing every preset file");
+            buffer.clear();
+            return false;
+        }
+
+        entries.reserve(header.count);
+        for (std::uint32_t i{}; i < header.count; ++i) {
+            fs::path::string_type file;
+            Entry entry;
+            std::uint32_t length{};
+            if (!reader.ReadString(file) || !reader.Read(entry.fingerprint) || !reader.Read(length)) break;
+
+            entry.offset = static_cast<std::size_t>(reader.position() - buffer.data());
+            entry.length = length;
+            if (!reader.Skip(length)) break;
+
+            entries.emplace(std::move(file), entry);
+        }
+
+        if (entries.size() != header.count || !reader.empty()) {
+            logger::warn("Preset cache is corrupt, parsing every preset file");
+            buffer.clear();
+            entries.clear();
+            return false;
+        }
+
+        logger::info("Loaded preset cache with {} files", entries.size());
+        return true;
+    }
+
+    std::optional<std::vector<Preset>> PresetCache::Find(const fs::path& a_file,
+                                                         const Fingerprint& a_fingerprint) const {
+        const auto it{entries.find(a_file.native())};
+        if (it == entries.end() || it->second.fingerprint != a_fingerprint) return {};
+
+        Reader reader{std::span{buffer}.subspan(it->second.offset, it->second.length)};
+
+        std::uint32_t count{};
+        if (!reader.Read(count)) return {};
+
+        auto& names{SliderNames::GetInstance()};
+        std::string name;
+
+        std::vector<Preset> ret;
+        ret.reserve(count);
+        for (std::uint32_t i{}; i < count; ++i) {
+            Preset preset;
+            std::uint32_t sliderCount{};
+            if (!reader.ReadString(preset.name) || !reader.ReadString(preset.body) || !reader.Read(sliderCount)) {
+                return {};
+            }
+
+            preset.sliders.reserve(sliderCount);
+            for (std::uint32_t j{}; j < sliderCount; ++j) {
+                float min{}, max{};
+                if (!reader.ReadString(name) || !reader.Read(min) || !reader.Read(max)) return {};
+
+                // Out of slider IDs: treat the file as a miss, so the parser reports and skips the presets involved
+                SliderID id{};
+                try {
+                    id = names.Intern(name);
+                } catch (const std::length_error&) {
+                    return {};
+                }
+                preset.sliders.push_back(Slider{id, min, max});
+            }
+
+            ret.push_back(std::move(preset));
+        }
+
+        return ret;
+    }
+
+    void PresetCache::Store(const fs::path& a_file, const Fingerprint& a_fingerprint,
+                            const std::vector<Preset>& a_presets) {
+        std::vector<char> body;
+        Write(body, static_cast<std::uint32_t>(a_presets.size()));
+        for (const auto& preset : a_presets) {
+            WriteString(body, std::string_view{preset.name});
+            WriteString(body, std::string_view{preset.body});
+            Write(body, static_cast<std::uint32_t>(preset.sliders.size()));
+            for (std::size_t i{}; i < preset.sliders.size(); ++i) {
+                WriteString(body, std::string_view{SliderNames::GetInstance().GetName(preset.sliders.ids[i])});
+                Write(body, preset.sliders.min[i]);
+                Write(body, preset.sliders.max[i]);
+            }
+        }
+
+        WriteString(pending, std::basic_string_view{a_file.native()});
+        Write(pending, a_fingerprint);
+        Write(pending, static_cast<std::uint32_t>(body.size()));
+        pending.insert(pending.end(), body.begin(), body.end());
+        ++pendingCount;
+    }
+
+    bool PresetCache::Save(const fs::path& a_path) const {
+        const Header header{Magic, Version, pendingCount, 0, pending.size(), Checksum(pending)};
+
+        auto temp{a_path};
+        temp += ".tmp";
+        {
+            std::ofstream file{temp, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            file.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+            if (!file) {
+                logger::warn("Failed to write the preset cache");
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(temp, a_path, ec);
+        if (ec) {
+            logger::warn("Failed to replace the preset cache: {}", ec.message());
+            fs::remove(temp, ec);
+            return false;
+        }
+
+        logger::info("Saved preset cache with {} files", pendingCount);
+        return true;
+    }
+}  // namespace PresetManager
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "PresetManager/PresetManager.h"
+
+namespace PresetManager {
+    // Binary cache of the parsed BodySlide presets. Every source file is stored with a fingerprint (path, size and
+    // last write time), so only files whose fingerprint changed since the last launch need to go through pugixml.
+    class PresetCache {
+    public:
+        struct Fingerprint {
+            std::uint64_t size{};
+            std::int64_t lastWriteTime{};
+
+            bool operator==(const Fingerprint&) const = default;
+        };
+
+        static constexpr std::uint32_t Magic{0x4350424F};  // "OBPC"
+        static constexpr std::uint32_t Version{1};
+
+        static Fingerprint GetFingerprint(const fs::directory_entry& a_entry);
+
+        // Reads the whole cache in one go and validates its header and checksum. Returns false (and leaves the cache
+        // empty) if the file is missing, corrupt or was written by a different version.
+        bool Load(const fs::path& a_path);
+
+        [[nodiscard]] std::optional<std::vector<Preset>> Find(const fs::path& a_file,
+                                                              const Fingerprint& a_fingerprint) const;
+        [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+        void Store(const fs::path& a_file, const Fingerprint& a_fingerprint, const std::vector<Preset>& a_presets);
+        bool Save(const fs::path& a_path) const;
+
+    private:
+        struct Entry {
+            Fingerprint fingerprint;
+            std::size_t offset{};
+            std::size_t length{};
+        };
+
+        std::vector<char> buffer;
+        std::unordered_map<fs::path::string_type, Entry> entries;
+
+        std::vector<char> pending;
+        std::uint32_t pendingCount{};
+    };
+}  // namespace PresetManager
@@ -1,6 +1,7 @@
 #include "PresetManager/PresetManager.h"
 
 #include "JSONParser/JSONParser.h"
+#include "PresetManager/PresetCache.h"
 #include "STL.h"
 
 PresetManager::PresetContainer PresetManager::PresetContainer::instance;
@@ -12,73 +13,255 @@ namespace PresetManager {
 
     PresetContainer& PresetContainer::GetInstance() { return instance; }
 
+    namespace {
+        // Parse result of one preset file from the last load, kept so a reload can reuse every file that didn't change.
+        // The presets are never modified once parsed; the sets of every snapshot built from the file point into them.
+        struct LoadedFile {
+            fs::path path;
+            PresetCache::Fingerprint fingerprint;
+            std::shared_ptr<const std::vector<Preset>> presets;  // nullptr if the file failed to parse
+        };
+
+        // Loads are serialized, so loadedFiles is only ever touched by one of them at a time
+        std::mutex loadLock;
+        std::vector<LoadedFile> loadedFiles;
+
+        // Scans the SliderPresets directory and builds a snapshot from it. Files whose fingerprint matches the previous
+        // load are reused as they are; the rest come from the disk cache (when a_useDiskCache is set) or the XML
+        // parser. Updates loadedFiles to the new state of the directory.
+        std::shared_ptr<PresetSnapshot> LoadPresets(const bool a_useDiskCache) {
+            const fs::path root_path(R"(Data\CalienteTools\BodySlide\SliderPresets)");
+            const fs::path cache_path(R"(Data\SKSE\Plugins\OBody_presetCache.bin)");
+
+            std::unordered_map<fs::path::string_type, std::size_t> previous;
+            previous.reserve(loadedFiles.size());
+            for (std::size_t i{}; i < loadedFiles.size(); ++i) previous.emplace(loadedFiles[i].path.native(), i);
+
+            std::vector<LoadedFile> files;
+            std::vector<std::size_t> changed;
+            for (const auto& entry : fs::directory_iterator(root_path)) {
+                const auto& path{entry.path()};
+                if (path.extension().c_str() != L".xml"sv) continue;
+                if (IsClothedSet(path.wstring())) continue;
+
+                auto& file{files.emplace_back(path, PresetCache::GetFingerprint(entry))};
+                if (const auto it{previous.find(path.native())};
+                    it != previous.end() && loadedFiles[it->second].fingerprint == file.fingerprint) {
+                    file.presets = loadedFiles[it->second].presets;
+                } else {
+                    changed.push_back(files.size() - 1);
+                }
+            }
+
+            // Files whose size and last write time match the cache are taken from it, everything else goes through
+            // the XML parser. If the cache is missing, corrupt or from another version, every file is a miss.
+            PresetCache cache;
+            if (a_useDiskCache && !changed.empty()) cache.Load(cache_path);
+
+            // Parsing is independent per file, so it is spread across a worker pool. Every file writes into its own
+            // slot, so the merge below still sees the files in directory order and the resulting sets are the same
+            // as a sequential load.
+            std::atomic_size_t cacheMisses{};
+            const auto threads{
+                std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), changed.size())};
+            {
+                const auto start{std::chrono::steady_clock::now()};
+                stl::parallel_for(
+                    changed.size(),
+                    [&](const std::size_t i) {
+                        auto& file{files[changed[i]]};
+                        auto parsed{cache.Find(file.path, file.fingerprint)};
+                        if (!parsed) {
+                            cacheMisses.fetch_add(1, std::memory_order_relaxed);
+                            parsed = LoadPresetFile(file.path);
+                        }
+                        if (parsed) file.presets = std::make_shared<const std::vector<Preset>>(std::move(*parsed));
+                    },
+                    threads);
+                const auto elapsed{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+                logger::info(
+                    "Loaded {} preset files ({} unchanged, {} parsed, {} from cache) on {} threads in {:.3f}s ({:.0f} "
+                    "files/s)",
+                    files.size(), files.size() - changed.size(), cacheMisses.load(),
+                    changed.size() - cacheMisses.load(), threads, elapsed,
+                    elapsed > 0.0 ? static_cast<double>(changed.size()) / elapsed : 0.0);
+            }
+
+            // Rewrite the cache when anything was re-parsed or a cached file disappeared. Files that failed to parse
+            // are left out so they keep being reported on every launch. Reloads leave the cache alone so their cost
+            // stays proportional to the changed files; the next launch picks the changes up instead.
+            if (a_useDiskCache) {
+                const auto cacheHits{changed.size() - cacheMisses.load()};
+                const auto validFiles{static_cast<std::size_t>(
+                    std::ranges::count_if(files, [](const auto& file) { return file.presets != nullptr; }))};
+                if (validFiles != cacheHits || cache.size() != cacheHits) {
+                    PresetCache updated;
+                    for (const auto& file : files) {
+                        if (file.presets) updated.Store(file.path, file.fingerprint, *file.presets);
+                    }
+                    updated.Save(cache_path);
+                }
+            }
+
+            const auto& blacklistedPresets{Parser::JSONParser::GetInstance().blacklistedPresetsFromRandomDistribution};
+
+            // The sets point into the parsed files instead of copying their presets, so files that didn't change cost
+            // a pointer and an index entry per preset
+            auto snapshot{std::make_shared<PresetSnapshot>()};
+            for (const auto& file : files) {
+                if (!file.presets) continue;
+
+                for (const auto& preset : *file.presets) {
+                    const bool blacklisted{blacklistedPresets.contains(preset.name)};
+
+                    auto& set{IsFemalePreset(preset)
+                                  ? (blacklisted ? snapshot->blacklistedFemalePresets : snapshot->femalePresets)
+                                  : (blacklisted ? snapshot->blacklistedMalePresets : snapshot->malePresets)};
+                    set.push_back({file.presets, &preset});
+                }
+            }
+
+            // The all* sets are the filtered presets followed by the blacklisted ones, each with its own name index
+            snapshot->allFemalePresets.append(snapshot->femalePresets);
+            snapshot->allFemalePresets.append(snapshot->blacklistedFemalePresets);
+
+            snapshot->allMalePresets.append(snapshot->malePresets);
+            snapshot->allMalePresets.append(snapshot->blacklistedMalePresets);
+
+            Parser::JSONParser::GetInstance().ResolvePresetRules(*snapshot);
+
+            std::size_t sliderCount{}, sliderMemory{};
+            for (const auto& file : files) {
+                if (!file.presets) continue;
+                for (const auto& preset : *file.presets) {
+                    sliderCount += preset.sliders.size();
+                    sliderMemory += preset.sliders.memory();
+                }
+            }
+
+            logger::info("Female presets: {}, Male presets: {}", snapshot->femalePresets.size(),
+                         snapshot->malePresets.size());
+            logger::info("Blacklisted: Female presets: {}, Male Presets: {}",
+                         snapshot->blacklistedFemalePresets.size(), snapshot->blacklistedMalePresets.size());
+            logger::info("Slider storage: {} sliders using {} KiB, {} distinct slider names", sliderCount,
+                         sliderMemory / 1024, SliderNames::GetInstance().size());
+
+            loadedFiles = std::move(files);
+            return snapshot;
+        }
+
+        // Publishes a snapshot from LoadPresets together with the number of files the load couldn't parse
+        void PublishPresets(std::shared_ptr<PresetSnapshot> a_snapshot) {
+            Parser::JSONParser::GetInstance().invalid_presets = static_cast<std::size_t>(
+                std::ranges::count_if(loadedFiles, [](const auto& file) { return file.presets == nullptr; }));
+
+            PresetContainer::GetInstance().Publish(std::move(a_snapshot));
+        }
+
+        // The background reload: whether one is running, and whether another was asked for while it was
+        std::mutex reloadLock;
+        bool reloadRunning{};
+        bool reloadPending{};
+    }  // namespace
+
     void GeneratePresets() {
-        const fs::path root_path(R"(Data\CalienteTools\BodySlide\SliderPresets)");
+        const std::scoped_lock lock{loadLock};
 
-        auto& container{PresetManager::PresetContainer::GetInstance()};
+        PublishPresets(LoadPresets(true));
+    }
 
-        auto& femalePresets{container.femalePresets};
-        auto& malePresets{container.malePresets};
+    void ReloadPresets() {
+        const std::scoped_lock lock{loadLock};
 
-        auto& allFemalePresets{container.allFemalePresets};
-        auto& allMalePresets{container.allMalePresets};
+        logger::info("Reloading Bodyslide presets");
 
-        auto& blacklistedFemalePresets{container.blacklistedFemalePresets};
-        auto& blacklistedMalePresets{container.blacklistedMalePresets};
-        auto& parser{Parser::JSONParser::GetInstance()};
-        auto& presetDistributionConfig{parser.presetDistributionConfig};
+        try {
+            PublishPresets(LoadPresets(false));
+            Parser::JSONParser::GetInstance().ClearDecisionCache();
+        } catch (const std::exception& ex) {
+            logger::error("Failed to reload the Bodyslide presets, keeping the current ones: {}", ex.what());
+        }
+    }
 
-        auto& blacklistedPresets{presetDistributionConfig["blacklistedPresetsFromRandomDistribution"]};
-        stl::RemoveDuplicatesInJsonArray(blacklistedPresets, presetDistributionConfig.GetAllocator());
-        const auto blacklistedPresetsBegin = blacklistedPresets.Begin();
-        const auto blacklistedPresetsEnd = blacklistedPresets.End();
+    void ReloadPresetsInBackground() {
+        {
+            const std::scoped_lock guard{reloadLock};
+            if (reloadRunning) {
+                // The running reload may have scanned the directory already, so it goes once more when it's done
+                reloadPending = true;
+                return;
+            }
+            reloadRunning = true;
+        }
 
-        for (const auto& entry : fs::directory_iterator(root_path)) {
-            const auto& path{entry.path()};
-            if (path.extension().c_str() != L".xml"sv) continue;
-            if (IsClothedSet(path.wstring())) continue;
+        std::thread([] {
+            for (;;) {
+                ReloadPresets();
 
-            pugi::xml_document doc;
-            if (auto result = doc.load_file(path.c_str(), pugi::parse_default, pugi::encoding_auto); !result) {
-                wchar_t buffer[2048];
-                swprintf_s(buffer, std::size(buffer), L"load failed: %s [%hs]", path.c_str(), result.description());
-                SPDLOG_WARN(buffer);
-                parser.invalid_presets++;
-                continue;
+                const std::scoped_lock guard{reloadLock};
+                if (!reloadPending) {
+                    reloadRunning = false;
+                    return;
+                }
+                reloadPending = false;
             }
+        }).detach();
+    }
 
-            auto presets = doc.child("SliderPresets");
-            for (const auto& node : presets) {
-                auto preset = GeneratePreset(node);
-                if (!preset) continue;
-
-                if (IsFemalePreset(*preset)) {
-                    if (std::find(blacklistedPresetsBegin, blacklistedPresetsEnd, preset.value().name.c_str()) !=
-                        blacklistedPresetsEnd) {
-                        blacklistedFemalePresets.push_back(*preset);
-                    } else {
-                        femalePresets.push_back(*preset);
-                    }
-                } else {
-                    if (std::find(blacklistedPresetsBegin, blacklistedPresetsEnd, preset.value().name.c_str()) !=
-                        blacklistedPresetsEnd) {
-                        blacklistedMalePresets.push_back(*preset);
-                    } else {
-                        malePresets.push_back(*preset);
-                    }
+    namespace {
+        // SliderPresets files only use elements and attributes, so the fast path skips everything parse_default does
+        // on top of that except entity expansion, which preset names do use.
+        constexpr unsigned int FastParseOptions{pugi::parse_minimal | pugi::parse_escapes};
+
+        std::vector<Preset> PresetsFromDocument(const pugi::xml_document& a_doc) {
+            std::vector<Preset> ret;
+            for (const auto& node : a_doc.child("SliderPresets")) {
+                try {
+                    if (auto preset = GeneratePreset(node)) ret.push_back(std::move(*preset));
+                } catch (const std::length_error& ex) {
+                    // SliderNames ran out of IDs. Only this preset is lost, the rest of the file and the load go on.
+                    logger::error("Skipping preset {}: {}", node.attribute("name").value(), ex.what());
                 }
             }
+
+            return ret;
         }
 
-        allFemalePresets = femalePresets;
-        allFemalePresets.insert_range(allFemalePresets.end(), blacklistedFemalePresets);
+        // Reads the file with a single bulk read and parses it in place, so pugixml neither opens the file itself nor
+        // copies any names or values out of the buffer. Returns nothing on any failure, leaving the reporting to the
+        // full parser.
+        std::optional<std::vector<Preset>> LoadPresetFileFast(const fs::path& a_path) {
+            std::error_code ec;
+            const auto size{static_cast<std::size_t>(fs::file_size(a_path, ec))};
+            if (ec || size == 0) return {};
+
+            const auto buffer{std::make_unique_for_overwrite<char[]>(size)};
+            {
+                std::ifstream file{a_path, std::ios::binary};
+                if (!file || !file.read(buffer.get(), static_cast<std::streamsize>(size))) return {};
+            }
+
+            pugi::xml_document doc;
+            if (!doc.load_buffer_inplace(buffer.get(), size, FastParseOptions, pugi::encoding_auto)) return {};
 
-        allMalePresets = malePresets;
-        allMalePresets.insert_range(allMalePresets.end(), blacklistedMalePresets);
+            return PresetsFromDocument(doc);
+        }
+    }  // namespace
+
+    std::optional<std::vector<Preset>> LoadPresetFile(const fs::path& a_path) {
+        if (auto presets{LoadPresetFileFast(a_path)}) return presets;
+
+        // Malformed or unreadable files go through the full parser, which either copes with them or reports why they
+        // failed; in the latter case the file is counted in invalid_presets.
+        pugi::xml_document doc;
+        if (auto result = doc.load_file(a_path.c_str(), pugi::parse_default, pugi::encoding_auto); !result) {
+            wchar_t buffer[2048];
+            swprintf_s(buffer, std::size(buffer), L"load failed: %s [%hs]", a_path.c_str(), result.description());
+            SPDLOG_WARN(buffer);
+            return {};
+        }
 
-        logger::info("Female presets: {}, Male presets: {}", femalePresets.size(), malePresets.size());
-        logger::info("Blacklisted: Female presets: {}, Male Presets: {}", blacklistedFemalePresets.size(),
-                     blacklistedMalePresets.size());
+        return PresetsFromDocument(doc);
     }
 
     std::optional<Preset> GeneratePreset(const pugi::xml_node& a_node) {
@@ -91,77 +274,63 @@ namespace PresetManager {
         return Preset{name.data(), body.data(), SliderSetFromNode(a_node, GetBodyType(body))};
     }
 
-    Preset GetPresetByName(const PresetSet& a_presetSet, const std::string_view a_name, const bool female) {
+    const Preset* GetPresetByName(const PresetSet& a_presetSet, const std::string_view a_name,
+                                  const PresetSet& a_fallback) {
         logger::info("Looking for preset: {}", a_name);
 
-        for (auto& preset : a_presetSet) {
-            if (stl::cmp(preset.name, a_name)) return preset;
-        }
+        if (const auto* const preset{a_presetSet.Find(a_name)}) return preset;
 
         logger::info("Preset not found, choosing a random one.");
-        const auto& container{PresetManager::PresetContainer::GetInstance()};
-        return GetRandomPreset(female ? container.femalePresets : container.malePresets);
+        return GetRandomPreset(a_fallback);
     }
 
-    Preset GetRandomPreset(const PresetSet& a_presetSet) {
+    const Preset* GetRandomPreset(const PresetSet& a_presetSet) {
+        if (a_presetSet.empty()) return nullptr;
+
         static_assert(std::is_same_v<decltype(0llu), decltype(a_presetSet.size())>,
                       "Ensure that below literal is of type std::size_t");
-        return a_presetSet[stl::random(0llu, a_presetSet.size())];
+        return &a_presetSet[stl::random(0llu, a_presetSet.size())];
     }
 
-    std::optional<Preset> GetPresetByNameForRandom(const PresetSet& a_presetSet, const std::string_view a_name) {
-        logger::info("Looking for preset: {}", a_name);
-
-        for (const auto& preset : a_presetSet) {
-            if (stl::cmp(preset.name, a_name)) {
-                return preset;
-            }
+    const Preset* GetRandomPresetFromCandidates(const PresetSnapshot& a_presets, const std::uint32_t a_slot,
+                                                const bool female) {
+        const auto& candidates{a_presets.GetCandidates(a_slot, female)};
+        if (candidates.empty()) {
+            logger::info("No valid presets for this rule, returning a random one");
+            return GetRandomPreset(a_presets.GetPresets(female));
         }
 
-        return {};
+        static_assert(std::is_same_v<decltype(0llu), decltype(candidates.size())>,
+                      "Ensure that below literal is of type std::size_t");
+        auto column{stl::random(0llu, candidates.size())};
+        if (!candidates.weights.empty()) column = candidates.weights.sample(column, stl::random(0.0f, 1.0f));
+
+        return &a_presets.GetAllPresets(female)[candidates.presets[column]];
     }
 
-    Preset GetRandomPresetByName(const PresetSet& a_presetSet, std::vector<std::string_view> a_presetNames,
-                                 const bool female) {
-        if (a_presetNames.empty()) {
-            logger::info("Preset names size is empty, returning a random one");
-            const auto& container{PresetManager::PresetContainer::GetInstance()};
-            return GetRandomPreset(female ? container.femalePresets : container.malePresets);
-        }
+    CandidateList ResolveCandidates(const PresetSet& a_presetSet, const std::span<const std::string> a_presetNames,
+                                    const std::span<const float> a_weights) {
+        CandidateList ret;
+        ret.presets.reserve(a_presetNames.size());
 
-        static_assert(std::is_same_v<decltype(0llu), decltype(a_presetNames.size())>,
-                      "Ensure that below literal is of type std::size_t");
-        const std::string_view chosenPreset{a_presetNames[stl::random(0llu, a_presetNames.size())]};
+        // A preset without a positive weight can never be drawn, so it isn't a candidate either. The config parser
+        // already drops them; this keeps the candidates and the table in step for any other caller.
+        std::vector<float> weights;
+        for (std::size_t i{}; i < a_presetNames.size(); ++i) {
+            if (!a_weights.empty() && !(a_weights[i] > 0.0f)) continue;
 
-        const std::optional<Preset> preset{GetPresetByNameForRandom(a_presetSet, chosenPreset)};
-
-        if (!preset.has_value()) {
-            if (const auto iterator{std::ranges::find(a_presetNames, chosenPreset)}; iterator != a_presetNames.end()) {
-                a_presetNames.erase(iterator);
+            if (const auto index{a_presetSet.IndexOf(a_presetNames[i])}) {
+                ret.presets.push_back(static_cast<std::uint32_t>(*index));
+                if (!a_weights.empty()) weights.push_back(a_weights[i]);
             }
-
-            return GetRandomPresetByName(a_presetSet, a_presetNames, female);
         }
 
-        return *preset;
-    }
+        if (!weights.empty()) ret.weights = stl::alias_table{weights};
 
-    bool IsFemalePreset(const Preset& a_preset) {
-        constexpr std::array body{"himbo"sv, "talos"sv, "sam"sv, "sos"sv, "savren"sv};
-        return !stl::contains(a_preset.body, body);
-    }
-
-    bool IsClothedSet(const std::string_view a_set) {
-        constexpr std::array clothed{"cloth"sv, "outfit"sv, "nevernude"sv, "bikini"sv, "feet"sv,
-                                     "hands"sv, "push"sv,   "cleavage"sv,  "armor"sv};
-        return stl::contains(a_set, clothed);
+        return ret;
     }
 
-    bool IsClothedSet(const std::wstring_view a_set) {
-        constexpr std::array clothed{L"cloth"sv, L"outfit"sv, L"nevernude"sv, L"bikini"sv, L"feet"sv,
-                                     L"hands"sv, L"push"sv,   L"cleavage"sv,  L"armor"sv};
-        return stl::contains(a_set, clothed);
-    }
+    bool IsFemalePreset(const Preset& a_preset) { return !ClassifyName(a_preset.body).male; }
 
     SliderSet SliderSetFromNode(const pugi::xml_node& a_node, const BodyType a_body) {
         SliderSet ret;
@@ -185,22 +354,24 @@ namespace PresetManager {
             AddSliderToSet(ret, Slider(name.data(), min, max), inverted);
         }
 
+        ret.shrink_to_fit();
         return ret;
     }
 
     void AddSliderToSet(SliderSet& a_sliderSet, Slider&& a_slider, [[maybe_unused]] bool a_inverted) {
-        if (const auto it = a_sliderSet.find(a_slider.name); it != a_sliderSet.end()) {
+        if (const auto it = std::ranges::find(a_sliderSet.ids, a_slider.id); it != a_sliderSet.ids.end()) {
             constexpr float val{};
-            auto& current = it->second;
-            if ((current.min == val) && (a_slider.min != val)) current.min = a_slider.min;
-            if ((current.max == val) && (a_slider.max != val)) current.max = a_slider.max;
+            const auto index{static_cast<std::size_t>(it - a_sliderSet.ids.begin())};
+            auto& currentMin = a_sliderSet.min[index];
+            auto& currentMax = a_sliderSet.max[index];
+            if ((currentMin == val) && (a_slider.min != val)) currentMin = a_slider.min;
+            if ((currentMax == val) && (a_slider.max != val)) currentMax = a_slider.max;
         } else {
-            a_sliderSet[a_slider.name] = std::move(a_slider);
+            a_sliderSet.push_back(a_slider);
         }
     }
 
     BodyType GetBodyType(const std::string_view a_body) {
-        constexpr std::array unp{"unp"sv, "coco"sv, "bhunp"sv, "uunp"sv};
-        return stl::contains(a_body, unp) ? BodyType::UNP : BodyType::CBBE;
+        return ClassifyName(a_body).unp ? BodyType::UNP : BodyType::CBBE;
     }
 }  // namespace PresetManager
@@ -1,12 +1,18 @@
 #pragma once
 
+#include "PresetManager/NameTraits.h"
+#include "PresetManager/SliderNames.h"
+#include "STLCore.h"
+
 namespace PresetManager {
     enum class BodyType { CBBE, UNP };
 
     struct Slider {
         Slider() = default;
-        Slider(const char* a_name, const float a_val) : name(a_name), min(a_val), max(a_val) {}
-        Slider(const char* a_name, float const a_min, const float a_max) : name(a_name), min(a_min), max(a_max) {}
+        Slider(const char* a_name, const float a_val) : Slider(a_name, a_val, a_val) {}
+        Slider(const char* a_name, float const a_min, const float a_max)
+            : id(SliderNames::GetInstance().Intern(a_name)), min(a_min), max(a_max) {}
+        Slider(const SliderID a_id, const float a_min, const float a_max) : id(a_id), min(a_min), max(a_max) {}
         ~Slider() = default;
 
         Slider(const Slider& a_other) = default;
@@ -15,12 +21,47 @@ namespace PresetManager {
         Slider& operator=(const Slider& a_other) = default;
         Slider& operator=(Slider&& a_other) = default;
 
-        std::string name;
+        [[nodiscard]] const char* name() const { return SliderNames::GetInstance().GetName(id); }
+
+        SliderID id{};
         float min = 0.f;
         float max = 0.f;
     };
 
-    using SliderSet = std::unordered_map<std::string, Slider>;
+    // Structure-of-arrays slider storage: ids[i], min[i] and max[i] describe the same slider. Presets hold a few dozen
+    // sliders at most, so lookups are a linear scan over the id array.
+    struct SliderSet {
+        [[nodiscard]] std::size_t size() const { return ids.size(); }
+        [[nodiscard]] bool empty() const { return ids.empty(); }
+        [[nodiscard]] Slider operator[](const std::size_t a_index) const {
+            return {ids[a_index], min[a_index], max[a_index]};
+        }
+        [[nodiscard]] std::size_t memory() const {
+            return ids.capacity() * sizeof(SliderID) + (min.capacity() + max.capacity()) * sizeof(float);
+        }
+
+        void reserve(const std::size_t a_size) {
+            ids.reserve(a_size);
+            min.reserve(a_size);
+            max.reserve(a_size);
+        }
+
+        void push_back(const Slider& a_slider) {
+            ids.push_back(a_slider.id);
+            min.push_back(a_slider.min);
+            max.push_back(a_slider.max);
+        }
+
+        void shrink_to_fit() {
+            ids.shrink_to_fit();
+            min.shrink_to_fit();
+            max.shrink_to_fit();
+        }
+
+        std::vector<SliderID> ids;
+        std::vector<float> min;
+        std::vector<float> max;
+    };
 
     struct Preset {
         Preset() = default;
@@ -34,18 +75,66 @@ namespace PresetManager {
         SliderSet sliders;
     };
 
-    using PresetSet = std::vector<Preset>;
-
-    class PresetContainer {
+    // Presets in load order together with a case-insensitive index from preset name to position. A set shares its
+    // presets rather than owning copies, so building, copying or appending sets never copies a preset. The index is
+    // filled as presets are added; when several presets share a name the first one wins, same as a front-to-back scan.
+    class PresetSet {
     public:
-        PresetContainer(PresetContainer&&) = delete;
-        PresetContainer(const PresetContainer&) = delete;
+        using value_type = Preset;
+        using const_iterator = boost::indirect_iterator<std::vector<std::shared_ptr<const Preset>>::const_iterator>;
+
+        [[nodiscard]] const_iterator begin() const { return const_iterator{presets.begin()}; }
+        [[nodiscard]] const_iterator end() const { return const_iterator{presets.end()}; }
+        [[nodiscard]] std::size_t size() const { return presets.size(); }
+        [[nodiscard]] bool empty() const { return presets.empty(); }
+        [[nodiscard]] const Preset& operator[](const std::size_t a_index) const { return *presets[a_index]; }
+
+        [[nodiscard]] std::optional<std::size_t> IndexOf(const std::string_view a_name) const {
+            const auto it{index.find(a_name)};
+            return it != index.end() ? std::optional{it->second} : std::nullopt;
+        }
+
+        [[nodiscard]] const Preset* Find(const std::string_view a_name) const {
+            const auto it{index.find(a_name)};
+            return it != index.end() ? presets[it->second].get() : nullptr;
+        }
+
+        void reserve(const std::size_t a_size) {
+            presets.reserve(a_size);
+            index.reserve(a_size);
+        }
+
+        void push_back(std::shared_ptr<const Preset> a_preset) {
+            index.emplace(a_preset->name, presets.size());
+            presets.push_back(std::move(a_preset));
+        }
+
+        // Adds every preset of a_other after the ones already in the set
+        void append(const PresetSet& a_other) {
+            reserve(size() + a_other.size());
+            for (const auto& preset : a_other.presets) push_back(preset);
+        }
 
-        PresetContainer& operator=(PresetContainer&&) = delete;
-        PresetContainer& operator=(const PresetContainer&) = delete;
+    private:
+        std::vector<std::shared_ptr<const Preset>> presets;
+        std::unordered_map<std::string_view, std::size_t, stl::ihash, stl::iequal> index;  // views of the names above
+    };
+
+    // Positions in a PresetSet that a distribution rule may pick from, resolved whenever the presets are (re)loaded.
+    // Rules with weighted presets also get an alias table over the same positions; without one every candidate is
+    // equally likely.
+    struct CandidateList {
+        std::vector<std::uint32_t> presets;
+        stl::alias_table weights;
 
-        std::vector<std::string> defaultSliders;
+        [[nodiscard]] std::size_t size() const { return presets.size(); }
+        [[nodiscard]] bool empty() const { return presets.empty(); }
+    };
 
+    // Everything built from the SliderPresets directory. A snapshot is never modified after it is published; a reload
+    // builds a new one and swaps it in, while readers holding the old one keep using it until they let go. The presets
+    // themselves belong to the parsed files and are shared by every snapshot built from the same file.
+    struct PresetSnapshot {
         PresetSet femalePresets;
         PresetSet malePresets;
 
@@ -55,26 +144,77 @@ namespace PresetManager {
         PresetSet allFemalePresets;
         PresetSet allMalePresets;
 
+        // Candidates of every distribution rule, indexed by the rule's slot (see Parser::PresetCandidates)
+        std::vector<CandidateList> femaleCandidates;
+        std::vector<CandidateList> maleCandidates;
+
+        // Presets used for random distribution, blacklisted ones excluded
+        [[nodiscard]] const PresetSet& GetPresets(const bool female) const {
+            return female ? femalePresets : malePresets;
+        }
+
+        // Borrowed view of every preset for the given sex, blacklisted ones included
+        [[nodiscard]] const PresetSet& GetAllPresets(const bool female) const {
+            return female ? allFemalePresets : allMalePresets;
+        }
+
+        [[nodiscard]] const CandidateList& GetCandidates(const std::uint32_t a_slot, const bool female) const {
+            return (female ? femaleCandidates : maleCandidates)[a_slot];
+        }
+    };
+
+    // Holds the current PresetSnapshot. Readers take it with Get() and keep the returned pointer alive for as long as
+    // they use presets from it, so publishing a new snapshot never has to wait for them.
+    class PresetContainer {
+    public:
+        PresetContainer(PresetContainer&&) = delete;
+        PresetContainer(const PresetContainer&) = delete;
+
+        PresetContainer& operator=(PresetContainer&&) = delete;
+        PresetContainer& operator=(const PresetContainer&) = delete;
+
         static PresetContainer& GetInstance();
 
+        [[nodiscard]] std::shared_ptr<const PresetSnapshot> Get() const {
+            return snapshot.load(std::memory_order_acquire);
+        }
+
+        void Publish(std::shared_ptr<const PresetSnapshot> a_snapshot) {
+            snapshot.store(std::move(a_snapshot), std::memory_order_release);
+        }
+
     private:
         static PresetContainer instance;
 
         PresetContainer() = default;
+
+        std::atomic<std::shared_ptr<const PresetSnapshot>> snapshot{std::make_shared<const PresetSnapshot>()};
     };
 
     bool IsFemalePreset(const Preset& a_preset);
-    bool IsClothedSet(std::string_view a_set);
-    bool IsClothedSet(std::wstring_view a_set);
 
-    Preset GetPresetByName(const PresetSet& a_presetSet, std::string_view a_name, bool female);
-    Preset GetRandomPreset(const PresetSet& a_presetSet);
-    Preset GetRandomPresetByName(const PresetSet& a_presetSet, std::vector<std::string_view> a_presetNames,
-                                 bool female);
+    // Preset lookups hand out pointers into the PresetSet they were given instead of copies. They stay valid for as
+    // long as the snapshot owning that set does; nullptr means no preset could be found.
+    const Preset* GetPresetByName(const PresetSet& a_presetSet, std::string_view a_name, const PresetSet& a_fallback);
+    const Preset* GetRandomPreset(const PresetSet& a_presetSet);
+    const Preset* GetRandomPresetFromCandidates(const PresetSnapshot& a_presets, std::uint32_t a_slot, bool female);
 
-    std::optional<Preset> GetPresetByNameForRandom(const PresetSet& a_presetSet, std::string_view a_name);
+    // a_weights is either empty or holds one weight per name
+    CandidateList ResolveCandidates(const PresetSet& a_presetSet, std::span<const std::string> a_presetNames,
+                                    std::span<const float> a_weights);
 
+    // Initial load at kDataLoaded. Throws if the SliderPresets directory can't be read.
     void GeneratePresets();
+
+    // Rescans the SliderPresets directory and publishes a new snapshot. Only files that were added or whose size or
+    // last write time changed since the previous load are parsed again. Errors are logged and keep the old snapshot.
+    void ReloadPresets();
+
+    // ReloadPresets on a worker thread, so the caller doesn't wait for the parse. At most one reload runs at a time:
+    // any number of calls made while one is running add up to a single reload after it.
+    void ReloadPresetsInBackground();
+
+    std::optional<std::vector<Preset>> LoadPresetFile(const fs::path& a_path);
     std::optional<Preset> GeneratePreset(const pugi::xml_node& a_node);
 
     SliderSet SliderSetFromNode(const pugi::xml_node& a_node, BodyType a_body);
@@ -0,0 +1,241 @@
+#include "PresetManager/RandomSliders.h"
+
+namespace PresetManager {
+    namespace {
+        using Type = RandomSliderToken::Type;
+
+        constexpr RandomSliderToken Range(const std::string_view a_name, const float a_min, const float a_max,
+                                          const int a_chance = 100) {
+            return {Type::kSlider, a_chance, a_name, a_min, a_max};
+        }
+
+        constexpr RandomSliderToken Fixed(const std::string_view a_name, const float a_value) {
+            return {Type::kSlider, 100, a_name, a_value, a_value};
+        }
+
+        constexpr RandomSliderToken Option(const int a_chance = 100) { return {Type::kOption, a_chance}; }
+
+        constexpr RandomSliderToken OneOf{Type::kOneOf};
+        constexpr RandomSliderToken End{Type::kEnd};
+
+        // clang-format off
+        constexpr RandomSliderToken nippleSliders[]{
+            OneOf,
+                Option(15), Range("AreolaSize", -1.0f, 0.0f),
+                Option(), Range("AreolaSize", 0.0f, 1.0f),
+            End,
+            Range("AreolaPull_v2", -0.25f, 1.0f, 75),
+            OneOf,
+                Option(15), Range("NippleLength", 0.2f, 0.3f),
+                Option(), Range("NippleLength", 0.0f, 0.1f),
+            End,
+            Range("NippleManga", -0.3f, 0.8f),
+            Range("NipplePerkManga", -0.3f, 1.2f, 25),
+            Range("NipBGone", 0.6f, 1.0f, 15),
+            Range("NippleSize", -0.5f, 0.3f),
+            Range("NippleDip", 0.0f, 1.0f),
+            Range("NippleCrease_v2", -0.4f, 1.0f),
+            Range("NipplePuffy_v2", 0.4f, 0.7f, 6),
+            Range("NippleThicc_v2", 0.0f, 0.9f, 35),
+            OneOf,
+                Option(2),
+                    OneOf,
+                        Option(50), Fixed("NippleInvert_v2", 1.0f),
+                        Option(), Range("NippleInvert_v2", 0.65f, 0.8f),
+                    End,
+            End,
+        };
+
+        constexpr RandomSliderToken genitalSliders[]{
+            OneOf,
+                // innie
+                Option(20),
+                    Range("Innieoutie", 0.95f, 1.1f),
+                    Range("Labiapuffyness", 0.75f, 1.25f, 50),
+                    Range("LabiaMorePuffyness_v2", 0.0f, 1.0f, 40),
+                    Range("Labiaprotrude", 0.0f, 0.5f),
+                    Range("Labiaprotrude2", 0.0f, 0.1f),
+                    Range("Labiaprotrudeback", 0.0f, 0.1f),
+                    Fixed("Labiaspread", 0.0f),
+                    Range("LabiaCrumpled_v2", 0.0f, 0.3f),
+                    Fixed("LabiaBulgogi_v2", 0.0f),
+                    Fixed("LabiaNeat_v2", 0.0f),
+                    Range("VaginaHole", -0.2f, 0.05f),
+                    Range("Clit", -0.4f, 0.25f),
+                // average
+                Option(75),
+                    Range("Innieoutie", 0.4f, 0.75f),
+                    Range("Labiapuffyness", 0.5f, 1.0f, 40),
+                    Range("LabiaMorePuffyness_v2", 0.0f, 0.75f, 30),
+                    Range("Labiaprotrude", 0.0f, 0.5f),
+                    Range("Labiaprotrude2", 0.0f, 0.75f),
+                    Range("Labiaprotrudeback", 0.0f, 1.0f),
+                    OneOf,
+                        Option(50),
+                            Range("Labiaspread", 0.0f, 1.0f),
+                            Range("LabiaCrumpled_v2", 0.0f, 0.7f),
+                            Range("LabiaBulgogi_v2", 0.0f, 0.1f, 60),
+                        Option(),
+                            Fixed("Labiaspread", 0.0f),
+                            Range("LabiaCrumpled_v2", 0.0f, 0.2f),
+                            Range("LabiaBulgogi_v2", 0.0f, 0.3f, 45),
+                    End,
+                    Fixed("LabiaNeat_v2", 0.0f),
+                    Range("VaginaHole", -0.2f, 0.4f),
+                    Range("Clit", -0.2f, 0.25f),
+                // outie
+                Option(),
+                    Range("Innieoutie", -0.25f, 0.3f),
+                    Range("Labiapuffyness", 0.2f, 0.5f, 30),
+                    Range("LabiaMorePuffyness_v2", 0.0f, 0.35f, 10),
+                    Range("Labiaprotrude", 0.0f, 1.0f),
+                    Range("Labiaprotrude2", 0.0f, 1.0f),
+                    Range("Labiaprotrudeback", 0.0f, 1.0f),
+                    Range("Labiaspread", 0.0f, 1.0f),
+                    Range("LabiaCrumpled_v2", 0.0f, 1.0f),
+                    Range("LabiaBulgogi_v2", 0.0f, 1.0f),
+                    Range("LabiaNeat_v2", 0.0f, 0.25f, 40),
+                    Range("VaginaHole", 0.0f, 1.0f),
+                    Range("Clit", -0.4f, 0.25f),
+            End,
+            Range("Vaginasize", 0.0f, 1.0f),
+            Range("ClitSwell_v2", -0.3f, 1.1f),
+            Range("Cutepuffyness", 0.0f, 1.0f),
+            Range("LabiaTightUp", 0.0f, 1.0f),
+            OneOf,
+                Option(60), Range("CBPC", -0.25f, 0.25f),
+                Option(), Range("CBPC", 0.6f, 1.0f),
+            End,
+            Range("AnalPosition_v2", 0.0f, 1.0f),
+            Range("AnalTexPos_v2", 0.0f, 1.0f),
+            Range("AnalTexPosRe_v2", 0.0f, 1.0f),
+            Fixed("AnalLoose_v2", -0.1f),
+        };
+        // clang-format on
+    }  // namespace
+
+    std::optional<RandomSliderTable> RandomSliderTable::Compile(const std::span<const RandomSliderToken> a_tokens) {
+        for (std::size_t i{}; i < a_tokens.size(); ++i) {
+            const auto& token{a_tokens[i]};
+            if (token.chance < 0 || token.chance > 100) {
+                logger::error("Random slider chance {} is not between 0 and 100", token.chance);
+                return std::nullopt;
+            }
+            if (token.type == Type::kSlider && (token.name.empty() || !(token.min <= token.max))) {
+                logger::error("Random slider '{}' needs a name and a min that isn't above its max", token.name);
+                return std::nullopt;
+            }
+        }
+
+        RandomSliderTable ret;
+        std::size_t pos{};
+        const auto sliders{CompileSequence(a_tokens, pos, ret.steps)};
+        if (!sliders) return std::nullopt;
+
+        if (pos != a_tokens.size()) {
+            logger::error("Random slider option outside of a oneOf");
+            return std::nullopt;
+        }
+
+        if (*sliders > RandomSliders::Capacity) {
+            logger::error("Random sliders can set up to {} sliders at once, but {} were given", RandomSliders::Capacity,
+                          *sliders);
+            return std::nullopt;
+        }
+
+        ret.steps.shrink_to_fit();
+        return ret;
+    }
+
+    std::optional<std::size_t> RandomSliderTable::CompileSequence(const std::span<const RandomSliderToken> a_tokens,
+                                                                  std::size_t& a_pos, std::vector<Step>& a_steps) {
+        auto& names{SliderNames::GetInstance()};
+
+        std::size_t sliders{};
+        while (a_pos < a_tokens.size()) {
+            const auto& token{a_tokens[a_pos]};
+            switch (token.type) {
+                case Type::kSlider:
+                    a_steps.push_back({Op::kSlider, static_cast<std::uint8_t>(token.chance), names.Intern(token.name),
+                                       0, token.min, token.max});
+                    ++sliders;
+                    ++a_pos;
+                    break;
+                case Type::kOneOf: {
+                    ++a_pos;
+
+                    std::size_t most{};
+                    std::vector<std::size_t> exits;
+                    while (a_pos < a_tokens.size() && a_tokens[a_pos].type == Type::kOption) {
+                        const auto chance{a_tokens[a_pos++].chance};
+
+                        // An option that always passes needs no roll, and makes the options after it unreachable
+                        std::optional<std::size_t> branch;
+                        if (chance < 100) {
+                            branch = a_steps.size();
+                            a_steps.push_back({Op::kBranch, static_cast<std::uint8_t>(chance)});
+                        }
+
+                        const auto option{CompileSequence(a_tokens, a_pos, a_steps)};
+                        if (!option) return std::nullopt;
+                        most = std::max(most, *option);
+
+                        // The last option just runs into whatever follows the choice
+                        if (a_pos < a_tokens.size() && a_tokens[a_pos].type == Type::kOption) {
+                            exits.push_back(a_steps.size());
+                            a_steps.push_back({Op::kJump});
+                        }
+
+                        if (branch) a_steps[*branch].next = static_cast<std::uint32_t>(a_steps.size());
+                    }
+
+                    if (a_pos == a_tokens.size() || a_tokens[a_pos].type != Type::kEnd) {
+                        logger::error("Random slider oneOf isn't closed");
+                        return std::nullopt;
+                    }
+                    ++a_pos;
+
+                    for (const auto exit : exits) a_steps[exit].next = static_cast<std::uint32_t>(a_steps.size());
+                    sliders += most;
+                    break;
+                }
+                case Type::kOption:
+                case Type::kEnd:
+                    return sliders;
+            }
+        }
+
+        return sliders;
+    }
+
+    void RandomSliderTable::Generate(RandomSliders& a_out) const {
+        a_out.count = 0;
+        for (std::size_t i{}; i < steps.size();) {
+            const auto& step{steps[i]};
+            const bool passed{step.chance >= 100 || stl::chance(step.chance)};
+            switch (step.op) {
+                case Op::kSlider:
+                    if (passed) {
+                        a_out.ids[a_out.count] = step.slider;
+                        a_out.values[a_out.count] = step.min < step.max ? stl::random(step.min, step.max) : step.min;
+                        ++a_out.count;
+                    }
+                    ++i;
+                    break;
+                case Op::kBranch:
+                    i = passed ? i + 1 : step.next;
+                    break;
+                case Op::kJump:
+                    i = step.next;
+                    break;
+            }
+        }
+    }
+
+    void RandomSliderTable::Generate(const std::span<RandomSliders> a_out) const {
+        for (auto& sliders : a_out) Generate(sliders);
+    }
+
+    std::span<const RandomSliderToken> DefaultNippleSliders() { return nippleSliders; }
+    std::span<const RandomSliderToken> DefaultGenitalSliders() { return genitalSliders; }
+}  // namespace PresetManager
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "PresetManager/PresetManager.h"
+
+namespace PresetManager {
+    // Source form of a random slider distribution, the same shape as an entry list of the randomSliders config key.
+    // A kOneOf token opens a choice, every kOption starts one of its alternatives and kEnd closes it. The options are
+    // rolled in order and the first one that passes is taken, so an option with a chance of 100 acts as the else.
+    struct RandomSliderToken {
+        enum class Type : std::uint8_t { kSlider, kOneOf, kOption, kEnd };
+
+        Type type{Type::kSlider};
+        int chance{100};          // percent, rolled the same way as stl::chance; 100 never rolls
+        std::string_view name{};  // kSlider only
+        float min{};              // min == max sets the slider to that value without drawing
+        float max{};
+    };
+
+    // Sliders one generator run produced for an actor. Fixed capacity, so generating never allocates.
+    struct RandomSliders {
+        static constexpr std::size_t Capacity{64};
+
+        [[nodiscard]] std::size_t size() const { return count; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+
+        std::array<SliderID, Capacity> ids{};
+        std::array<float, Capacity> values{};
+        std::uint32_t count{};
+    };
+
+    // A random slider distribution compiled into a flat list of steps. Choices become a conditional jump to the next
+    // option and a jump past the choice at the end of each option, so generating is a single forward walk.
+    class RandomSliderTable {
+    public:
+        // Returns nothing, after logging why, if the tokens are malformed or a single run could produce more sliders
+        // than RandomSliders holds
+        static std::optional<RandomSliderTable> Compile(std::span<const RandomSliderToken> a_tokens);
+
+        void Generate(RandomSliders& a_out) const;
+
+        // Fills every element with an independent run, for sampling many actors at once
+        void Generate(std::span<RandomSliders> a_out) const;
+
+        [[nodiscard]] std::size_t size() const { return steps.size(); }
+        [[nodiscard]] bool empty() const { return steps.empty(); }
+
+    private:
+        enum class Op : std::uint8_t { kSlider, kBranch, kJump };
+
+        struct Step {
+            Op op{};
+            std::uint8_t chance{100};
+            SliderID slider{};
+            std::uint32_t next{};  // kBranch: step to go on with when the roll fails; kJump: step to go on with
+            float min{};
+            float max{};
+        };
+
+        // Compiles the tokens from a_pos up to the kOption or kEnd closing them, and returns the most sliders a single
+        // run through them can set
+        static std::optional<std::size_t> CompileSequence(std::span<const RandomSliderToken> a_tokens,
+                                                          std::size_t& a_pos, std::vector<Step>& a_steps);
+
+        std::vector<Step> steps;
+    };
+
+    // Distributions OBody ships with, used unless randomSliders overrides them
+    std::span<const RandomSliderToken> DefaultNippleSliders();
+    std::span<const RandomSliderToken> DefaultGenitalSliders();
+}  // namespace PresetManager
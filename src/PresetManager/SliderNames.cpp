@@ -0,0 +1,34 @@
+#include "PresetManager/SliderNames.h"
+
+PresetManager::SliderNames PresetManager::SliderNames::instance;
+
+namespace PresetManager {
+    SliderNames& SliderNames::GetInstance() { return instance; }
+
+    SliderID SliderNames::Intern(const std::string_view a_name) {
+        {
+            const std::shared_lock readLock{lock};
+            if (const auto it{ids.find(a_name)}; it != ids.end()) return it->second;
+        }
+
+        const std::unique_lock writeLock{lock};
+        if (const auto it{ids.find(a_name)}; it != ids.end()) return it->second;
+
+        if (names.size() > std::numeric_limits<SliderID>::max()) {
+            throw std::length_error("Too many distinct slider names in the Bodyslide presets");
+        }
+
+        const auto& name{names.emplace_back(a_name)};
+        return ids.emplace(name, static_cast<SliderID>(names.size() - 1)).first->second;
+    }
+
+    const char* SliderNames::GetName(const SliderID a_id) const {
+        const std::shared_lock readLock{lock};
+        return names[a_id].c_str();
+    }
+
+    std::size_t SliderNames::size() const {
+        const std::shared_lock readLock{lock};
+        return names.size();
+    }
+}  // namespace PresetManager
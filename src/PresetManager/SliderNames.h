@@ -0,0 +1,32 @@
+#pragma once
+
+namespace PresetManager {
+    using SliderID = std::uint16_t;
+
+    // Process-wide table of slider names. Sliders only carry the index of their name, so each of the few hundred
+    // distinct names is stored once no matter how many presets use it. Safe to intern from the loader's workers.
+    class SliderNames {
+    public:
+        SliderNames(SliderNames&&) = delete;
+        SliderNames(const SliderNames&) = delete;
+
+        SliderNames& operator=(SliderNames&&) = delete;
+        SliderNames& operator=(const SliderNames&) = delete;
+
+        static SliderNames& GetInstance();
+
+        // Throws std::length_error when a new name comes in after every SliderID is taken
+        SliderID Intern(std::string_view a_name);
+        [[nodiscard]] const char* GetName(SliderID a_id) const;
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        static SliderNames instance;
+
+        SliderNames() = default;
+
+        mutable std::shared_mutex lock;
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, SliderID> ids;
+    };
+}  // namespace PresetManager
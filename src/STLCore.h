@@ -0,0 +1,403 @@
+#pragma once
+
+// The part of stl that only needs the standard library, Boost and the logger, so tests/ can build it without the game
+namespace stl {
+    inline bool contains(const std::string_view a_text, const std::string_view a_sub) {
+        return boost::algorithm::icontains(a_text, a_sub);
+    }
+
+    inline bool contains(const std::wstring_view a_text, const std::wstring_view a_sub) {
+        return boost::algorithm::icontains(a_text, a_sub);
+    }
+
+    template <class T, std::size_t N>
+    bool contains(const std::string_view a_text, std::array<T, N> const& a_subs) {
+        for (auto& sub : a_subs) {
+            if (contains(a_text, sub)) return true;
+        }
+
+        return false;
+    }
+
+    template <class T, std::size_t N>
+    bool contains(std::wstring_view const a_text, std::array<T, N> const& a_subs) {
+        for (auto& sub : a_subs) {
+            if (contains(a_text, sub)) return true;
+        }
+
+        return false;
+    }
+
+    inline bool cmp(const std::string_view a_str1, const std::string_view a_str2) {
+        return boost::algorithm::iequals(a_str1, a_str2);
+    }
+
+    // Case-insensitive hash and equality for unordered containers, consistent with stl::cmp. Both are transparent,
+    // so lookups with a std::string_view or const char* don't allocate a key.
+    struct ihash {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view a_str) const noexcept {
+            // FNV-1a over the ASCII-folded characters
+            std::size_t hash{14695981039346656037ull};
+            for (const char c : a_str) {
+                hash ^= static_cast<unsigned char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    };
+
+    struct iequal {
+        using is_transparent = void;
+
+        bool operator()(const std::string_view a_str1, const std::string_view a_str2) const {
+            return cmp(a_str1, a_str2);
+        }
+    };
+
+    // Open-addressing hash map keyed by non-zero 32-bit IDs such as FormIDs. Linear probing over a power-of-two table
+    // that is kept at most half full; keys and values live in separate arrays so a probe only touches the keys.
+    // Entries can't be erased, and the first value inserted for a key wins.
+    template <class T>
+    class id_map {
+    public:
+        void reserve(const std::size_t a_count) {
+            std::size_t capacity{16};
+            while (capacity < a_count * 2) capacity *= 2;
+            if (capacity > keys.size()) rehash(capacity);
+        }
+
+        bool emplace(const std::uint32_t a_key, T a_value) {
+            if (a_key == 0) return false;
+            if ((count + 1) * 2 > keys.size()) rehash(std::max<std::size_t>(16, keys.size() * 2));
+
+            auto index{slot(a_key)};
+            for (; keys[index] != 0; index = (index + 1) & (keys.size() - 1)) {
+                if (keys[index] == a_key) return false;
+            }
+
+            keys[index] = a_key;
+            values[index] = std::move(a_value);
+            ++count;
+            return true;
+        }
+
+        [[nodiscard]] const T* find(const std::uint32_t a_key) const {
+            if (count == 0 || a_key == 0) return nullptr;
+
+            for (auto index{slot(a_key)}; keys[index] != 0; index = (index + 1) & (keys.size() - 1)) {
+                if (keys[index] == a_key) return &values[index];
+            }
+
+            return nullptr;
+        }
+
+        [[nodiscard]] bool contains(const std::uint32_t a_key) const { return find(a_key) != nullptr; }
+        [[nodiscard]] std::size_t size() const { return count; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+
+    private:
+        [[nodiscard]] std::size_t slot(const std::uint32_t a_key) const {
+            // Fibonacci hashing, so FormIDs that only differ in their low bits still spread over the whole table
+            return static_cast<std::size_t>((a_key * 0x9E3779B97F4A7C15ull) >> 32) & (keys.size() - 1);
+        }
+
+        void rehash(const std::size_t a_capacity) {
+            auto oldKeys{std::exchange(keys, std::vector<std::uint32_t>(a_capacity))};
+            auto oldValues{std::exchange(values, std::vector<T>(a_capacity))};
+            count = 0;
+
+            for (std::size_t i{}; i < oldKeys.size(); ++i) {
+                if (oldKeys[i] != 0) emplace(oldKeys[i], std::move(oldValues[i]));
+            }
+        }
+
+        std::vector<std::uint32_t> keys;  // 0 marks an empty slot
+        std::vector<T> values;
+        std::size_t count{};
+    };
+
+    class id_set {
+    public:
+        void reserve(const std::size_t a_count) { map.reserve(a_count); }
+        bool insert(const std::uint32_t a_key) { return map.emplace(a_key, {}); }
+
+        [[nodiscard]] bool contains(const std::uint32_t a_key) const { return map.contains(a_key); }
+        [[nodiscard]] std::size_t size() const { return map.size(); }
+        [[nodiscard]] bool empty() const { return map.empty(); }
+
+    private:
+        struct none {};
+
+        id_map<none> map;
+    };
+
+    // Set of strings for exact, case-sensitive lookups, built once and then only read. Every slot keeps the hash of
+    // its string, so a probe only compares characters when the hashes already match; lookups cost one hash of the
+    // query no matter how many strings the set holds.
+    template <class String>
+    class basic_string_set {
+    public:
+        basic_string_set() = default;
+
+        explicit basic_string_set(std::vector<String> a_strings) : strings(std::move(a_strings)) {
+            std::size_t capacity{16};
+            while (capacity < strings.size() * 2) capacity *= 2;
+            slots.resize(capacity);
+
+            for (std::size_t i{}; i < strings.size(); ++i) {
+                const auto hash{std::hash<std::string_view>{}(strings[i])};
+                auto index{hash & (slots.size() - 1)};
+                for (; slots[index].entry != 0; index = (index + 1) & (slots.size() - 1)) {
+                    if (slots[index].hash == hash && strings[slots[index].entry - 1] == strings[i]) break;
+                }
+                if (slots[index].entry == 0) slots[index] = {hash, static_cast<std::uint32_t>(i + 1)};
+            }
+        }
+
+        [[nodiscard]] bool contains(const std::string_view a_str) const {
+            if (strings.empty()) return false;
+
+            const auto hash{std::hash<std::string_view>{}(a_str)};
+            for (auto index{hash & (slots.size() - 1)}; slots[index].entry != 0;
+                 index = (index + 1) & (slots.size() - 1)) {
+                if (slots[index].hash == hash && strings[slots[index].entry - 1] == a_str) return true;
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] std::size_t size() const { return strings.size(); }
+        [[nodiscard]] bool empty() const { return strings.empty(); }
+
+    private:
+        struct slot {
+            std::size_t hash{};
+            std::uint32_t entry{};  // position in strings plus one, 0 marks an empty slot
+        };
+
+        std::vector<String> strings;
+        std::vector<slot> slots;
+    };
+
+    using string_set = basic_string_set<std::string>;
+    // Views into strings that outlive the set, such as names owned by game forms
+    using string_view_set = basic_string_set<std::string_view>;
+
+    // Vose alias table for drawing from a fixed, weighted set of choices in constant time: pick a column uniformly,
+    // then keep it or take its alias depending on a coin in [0, 1). Weights don't need to be normalized; negative
+    // ones count as 0, and a table whose weights are all 0 stays empty.
+    class alias_table {
+    public:
+        alias_table() = default;
+
+        explicit alias_table(const std::span<const float> a_weights) {
+            double sum{};
+            for (const auto weight : a_weights) sum += std::max(weight, 0.0f);
+            if (sum <= 0.0) return;
+
+            const auto count{a_weights.size()};
+            probability.resize(count, 1.0f);
+            alias.resize(count);
+
+            std::vector<double> scaled(count);
+            std::vector<std::uint32_t> small, large;
+            for (std::size_t i{}; i < count; ++i) {
+                scaled[i] = std::max(a_weights[i], 0.0f) * static_cast<double>(count) / sum;
+                (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+            }
+
+            while (!small.empty() && !large.empty()) {
+                const auto less{small.back()};
+                const auto more{large.back()};
+                small.pop_back();
+                large.pop_back();
+
+                probability[less] = static_cast<float>(scaled[less]);
+                alias[less] = more;
+                scaled[more] += scaled[less] - 1.0;
+                (scaled[more] < 1.0 ? small : large).push_back(more);
+            }
+
+            // Whatever is left is 1 up to rounding, so it always keeps its own column
+            for (const auto i : large) alias[i] = i;
+            for (const auto i : small) alias[i] = i;
+        }
+
+        [[nodiscard]] std::size_t sample(const std::size_t a_column, const float a_coin) const {
+            return a_coin < probability[a_column] ? a_column : alias[a_column];
+        }
+
+        [[nodiscard]] std::size_t size() const { return probability.size(); }
+        [[nodiscard]] bool empty() const { return probability.empty(); }
+
+    private:
+        std::vector<float> probability;
+        std::vector<std::uint32_t> alias;
+    };
+
+    // xoshiro256** by Blackman and Vigna: 32 bytes of state and a few shifts per draw, seeded through splitmix64 so
+    // that any 64-bit seed, including small ones like FormIDs, gives a well mixed state
+    class xoshiro256ss {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit xoshiro256ss(const std::uint64_t a_seed) { seed(a_seed); }
+
+        void seed(std::uint64_t a_seed) {
+            for (auto& word : state) {
+                a_seed += 0x9E3779B97F4A7C15ull;
+                auto z{a_seed};
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            const auto ret{std::rotl(state[1] * 5, 7) * 9};
+            const auto t{state[1] << 17};
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = std::rotl(state[3], 45);
+            return ret;
+        }
+
+    private:
+        std::array<std::uint64_t, 4> state{};
+    };
+
+    // Engine behind random and chance, one per thread and seeded from std::random_device on first use
+    inline xoshiro256ss& rng() {
+        thread_local xoshiro256ss engine{(std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()};
+        return engine;
+    }
+
+    // Reseeds the calling thread's engine until the scope ends, so every draw in between is reproducible; the
+    // previous sequence picks up where it left off afterwards
+    class deterministic_random {
+    public:
+        explicit deterministic_random(const std::uint64_t a_seed) : saved(rng()) { rng().seed(a_seed); }
+        ~deterministic_random() { rng() = saved; }
+
+        deterministic_random(const deterministic_random&) = delete;
+        deterministic_random& operator=(const deterministic_random&) = delete;
+
+    private:
+        xoshiro256ss saved;
+    };
+
+    // ReSharper disable once CppNotAllPathsReturnValue
+    template <class T>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    T random(T min, T max) {
+        // non-inclusive i.e., [min, max)
+        if (min >= max) {
+            char errorMessage[256];
+            if constexpr (std::is_floating_point_v<T>) {
+                sprintf_s(errorMessage, std::size(errorMessage),
+                          "The Value of min: '%f' must be lesser than the value of max: '%f'", min, max); //max length possible: 153
+            } else {
+                sprintf_s(errorMessage, std::size(errorMessage),
+                          "The Value of min: '%lld' must be lesser than the value of max: '%lld'",
+                          static_cast<long long>(min), static_cast<long long>(max)); //max length possible: 99
+            }
+            throw std::invalid_argument(errorMessage);
+        }
+        auto& gen{rng()};
+        if constexpr (std::is_integral_v<T>) {
+            // The modulo bias is at most range / 2^64, far below anything a preset pick could show
+            using U = std::make_unsigned_t<T>;
+            const auto range{static_cast<U>(static_cast<U>(max) - static_cast<U>(min))};
+            return static_cast<T>(static_cast<U>(min) + static_cast<U>(gen() % range));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            const double unit{static_cast<double>(gen() >> 11) * 0x1.0p-53};
+            const auto ret{static_cast<T>(min + ((max - min) * unit))};
+            return ret < max ? ret : std::nextafter(max, min);
+        }
+    }
+
+    inline bool chance(const int a_chance) {
+        const auto roll = random(0.0f, 99.0f);
+        return roll <= static_cast<float>(a_chance);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr std::array<T, N> to_set(std::initializer_list<T> const& input) {
+        std::array<T, N> elements{};
+        std::size_t size = 0;
+
+        for (auto& value : input) {
+            if (std::find(elements.begin(), elements.begin() + size, value) == elements.begin() + size) {
+                if (size >= N) throw std::exception("Set is full, not enough space");
+                elements[size++] = value;
+            }
+        }
+
+        if (size != N) throw std::out_of_range("Not the smallest possible set");
+        return elements;
+    }
+
+    // Runs a_func(i) for every i in [0, a_count) on a pool of up to a_threads workers, the calling thread included.
+    // Indices are handed out dynamically so uneven work items don't stall the pool. The first exception thrown by a
+    // worker is rethrown on the calling thread once every worker has finished.
+    template <class F>
+    void parallel_for(const std::size_t a_count, F&& a_func,
+                      std::size_t a_threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if (a_count == 0) return;
+        a_threads = std::clamp<std::size_t>(a_threads, 1, a_count);
+
+        std::atomic_size_t next{};
+        std::exception_ptr error;
+        std::once_flag errorFlag;
+
+        const auto worker{[&] {
+            try {
+                for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < a_count;) a_func(i);
+            } catch (...) {
+                std::call_once(errorFlag, [&] { error = std::current_exception(); });
+                next.store(a_count, std::memory_order_relaxed);
+            }
+        }};
+
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(a_threads - 1);
+            for (std::size_t i{1}; i < a_threads; ++i) pool.emplace_back(worker);
+            worker();
+        }
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    class timeit {
+    public:
+        explicit timeit(const std::source_location& a_curr = std::source_location::current())
+            : name(a_curr.function_name()) {}
+
+        // For timing one phase of a function; the label has to outlive the timer
+        explicit timeit(const std::string_view a_label) : name(a_label) {}
+
+        ~timeit() {
+            const auto stop{std::chrono::steady_clock::now() - start};
+            logger::info(
+                "Time Taken in '{}' is {} nanoseconds or {} microseconds or {} milliseconds or {} seconds or "
+                "{} minutes",
+                name, stop.count(), std::chrono::duration_cast<std::chrono::microseconds>(stop).count(),
+                std::chrono::duration_cast<std::chrono::milliseconds>(stop).count(),
+                std::chrono::duration_cast<std::chrono::seconds>(stop).count(),
+                std::chrono::duration_cast<std::chrono::minutes>(stop).count());
+        }
+
+    private:
+        std::string_view name;
+        std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    };
+}  // namespace stl
@@ -1,5 +1,6 @@
 #include "Body/Body.h"
 #include "Body/Event.h"
+#include "Body/MorphScheduler.h"
 #include "Papyrus/Papyrus.h"
 #include "JSONParser/JSONParser.h"
 #include "PresetManager/PresetManager.h"
@@ -99,6 +100,13 @@ namespace {
                 return;
             }
 
+            // Handles and runtime FormIDs from the game being left behind don't mean anything in the next one
+            case SKSE::MessagingInterface::kPreLoadGame: {
+                Body::MorphScheduler::GetInstance().CancelAll();
+                Parser::JSONParser::GetInstance().ClearDecisionCache();
+                return;
+            }
+
             case SKSE::MessagingInterface::kPostLoadGame: {
                 logger::info("Game finished loading");
                 Event::OBodyEventHandler::Register();
@@ -0,0 +1,368 @@
+// Microbenchmarks behind the numbers quoted in the commits that introduced these pieces. Each one runs the current
+// code against the code it replaced. Run every benchmark, or only those named on the command line:
+//   obody_benchmarks [parallel_for] [preset_lookup] [preset_snapshot] [preset_parse] [classify] [id_set]
+//                    [string_set] [random] [random_sliders]
+#include "LegacyRandomSliders.h"
+#include "PresetManager/PresetManager.h"
+#include "PresetManager/RandomSliders.h"
+
+#ifdef OBODY_BENCHMARK_PUGIXML
+    #include <fstream>
+    #include <pugixml.hpp>
+#endif
+
+// Every replaceable allocation and deallocation function is routed through Allocate and Deallocate, so each
+// pointer is always released by the function family that made it and the counter sees array and aligned news too
+namespace {
+    std::atomic_size_t allocations{};
+
+    void* Allocate(const std::size_t a_size, const std::align_val_t a_alignment) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        // aligned_alloc wants the size to be a multiple of the alignment
+        const auto alignment{static_cast<std::size_t>(a_alignment)};
+        const auto size{(std::max<std::size_t>(a_size, 1) + alignment - 1) / alignment * alignment};
+        if (void* ret{std::aligned_alloc(alignment, size)}) return ret;
+        throw std::bad_alloc{};
+    }
+
+    void Deallocate(void* a_ptr) noexcept { std::free(a_ptr); }
+
+    constexpr std::align_val_t DefaultAlignment{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+}  // namespace
+
+void* operator new(const std::size_t a_size) { return Allocate(a_size, DefaultAlignment); }
+void* operator new[](const std::size_t a_size) { return Allocate(a_size, DefaultAlignment); }
+void* operator new(const std::size_t a_size, const std::align_val_t a_alignment) {
+    return Allocate(a_size, a_alignment);
+}
+void* operator new[](const std::size_t a_size, const std::align_val_t a_alignment) {
+    return Allocate(a_size, a_alignment);
+}
+
+void operator delete(void* a_ptr) noexcept { Deallocate(a_ptr); }
+void operator delete[](void* a_ptr) noexcept { Deallocate(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { Deallocate(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t) noexcept { Deallocate(a_ptr); }
+void operator delete(void* a_ptr, std::align_val_t) noexcept { Deallocate(a_ptr); }
+void operator delete[](void* a_ptr, std::align_val_t) noexcept { Deallocate(a_ptr); }
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept { Deallocate(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t, std::align_val_t) noexcept { Deallocate(a_ptr); }
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Keeps results alive so the optimizer can't drop the work being measured
+    template <class T>
+    void Consume(const T& a_value) {
+        static volatile std::size_t sink;
+        sink = sink + static_cast<std::size_t>(a_value);
+    }
+
+    // Runs a_func a_count times and returns the average time per run in nanoseconds
+    template <class F>
+    double Measure(const std::size_t a_count, F&& a_func) {
+        const auto start{Clock::now()};
+        for (std::size_t i{}; i < a_count; ++i) a_func(i);
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(a_count);
+    }
+
+    // Spreading per-file work over a pool. The work is a stand-in for parsing one preset file.
+    void BenchParallelFor() {
+        constexpr std::size_t files{2000};
+        const auto parse{[](const std::size_t a_file) {
+            std::uint64_t hash{a_file};
+            for (int i{}; i < 200000; ++i) hash = (hash ^ static_cast<std::uint64_t>(i)) * 1099511628211ull;
+            Consume(hash);
+        }};
+
+        const auto threads{std::max(1u, std::thread::hardware_concurrency())};
+        const auto sequential{Measure(1, [&](std::size_t) { stl::parallel_for(files, parse, 1); })};
+        const auto pooled{Measure(1, [&](std::size_t) { stl::parallel_for(files, parse, threads); })};
+
+        fmt::print("parallel_for, {} files: 1 thread {:.0f} files/s, {} threads {:.0f} files/s\n", files,
+                   files / sequential * 1e9, threads, files / pooled * 1e9);
+    }
+
+    // Like Measure, and also returns the average number of allocations per run
+    template <class F>
+    std::pair<double, double> MeasureAllocations(const std::size_t a_count, F&& a_func) {
+        const auto before{allocations.load()};
+        const auto ns{Measure(a_count, std::forward<F>(a_func))};
+        return {ns, static_cast<double>(allocations.load() - before) / static_cast<double>(a_count)};
+    }
+
+    // The PresetSet from before presets were shared: presets held by value, indexed by owned copies of their names
+    struct ValuePresetSet {
+        std::vector<PresetManager::Preset> presets;
+        std::unordered_map<std::string, std::size_t, stl::ihash, stl::iequal> index;
+
+        [[nodiscard]] const PresetManager::Preset* Find(const std::string_view a_name) const {
+            const auto it{index.find(a_name)};
+            return it != index.end() ? &presets[it->second] : nullptr;
+        }
+
+        void push_back(PresetManager::Preset a_preset) {
+            index.emplace(a_preset.name, presets.size());
+            presets.push_back(std::move(a_preset));
+        }
+    };
+
+    // One parsed preset file, the way LoadPresets keeps it
+    std::shared_ptr<const std::vector<PresetManager::Preset>> MakePresetFile(const std::size_t a_count) {
+        auto ret{std::make_shared<std::vector<PresetManager::Preset>>()};
+        for (std::size_t i{}; i < a_count; ++i) {
+            PresetManager::SliderSet sliders;
+            for (int slider{}; slider < 40; ++slider) {
+                sliders.push_back({fmt::format("Slider{}", slider).c_str(), 0.1f * slider, 0.2f * slider});
+            }
+            ret->emplace_back(fmt::format("Preset {}", i).c_str(), "CBBE 3BBB Body Amazing", std::move(sliders));
+        }
+        return ret;
+    }
+
+    // Looking a rule's preset up in a copy of the preset set, as the distribution did, or in the set itself
+    void BenchPresetLookup() {
+        constexpr std::size_t lookups{200};
+        const auto file{MakePresetFile(4000)};
+
+        ValuePresetSet values;
+        PresetManager::PresetSet shared;
+        for (const auto& preset : *file) {
+            values.push_back(preset);
+            shared.push_back({file, &preset});
+        }
+
+        const auto [copied, copiedAllocations]{MeasureAllocations(lookups, [&](const std::size_t i) {
+            const auto copy{values};
+            Consume(copy.Find(fmt::format("Preset {}", i * 7 % 4000)) != nullptr);
+        })};
+        const auto [borrowed, borrowedAllocations]{MeasureAllocations(lookups, [&](const std::size_t i) {
+            Consume(shared.Find(fmt::format("Preset {}", i * 7 % 4000)) != nullptr);
+        })};
+
+        fmt::print("preset lookup, 4000 presets: copied set {:.0f} allocations and {:.0f} ns per lookup, borrowed set "
+                   "{:.0f} allocations and {:.0f} ns per lookup\n",
+                   copiedAllocations, copied, borrowedAllocations, borrowed);
+    }
+
+    // Building a snapshot's sets from unchanged files: copying every preset into its per-sex set and that set again
+    // into the all* set, or sharing the parsed presets with both
+    void BenchPresetSnapshot() {
+        constexpr std::size_t builds{20};
+        const auto file{MakePresetFile(4000)};
+
+        const auto [copied, copiedAllocations]{MeasureAllocations(builds, [&](std::size_t) {
+            ValuePresetSet female;
+            for (const auto& preset : *file) female.push_back(preset);
+            const auto all{female};
+            Consume(all.presets.size());
+        })};
+        const auto [shared, sharedAllocations]{MeasureAllocations(builds, [&](std::size_t) {
+            PresetManager::PresetSet female;
+            for (const auto& preset : *file) female.push_back({file, &preset});
+            PresetManager::PresetSet all;
+            all.append(female);
+            Consume(all.size());
+        })};
+
+        fmt::print("preset snapshot, 4000 presets: copied {:.0f} allocations and {:.2f} ms per build, shared {:.0f} "
+                   "allocations and {:.2f} ms per build\n",
+                   copiedAllocations, copied / 1e6, sharedAllocations, shared / 1e6);
+    }
+
+#ifdef OBODY_BENCHMARK_PUGIXML
+    // pugixml's load_file with parse_default against one bulk read parsed in place with the minimal flags
+    void BenchPresetParse() {
+        const auto dir{fs::temp_directory_path() / "obody_preset_benchmark"};
+        fs::create_directories(dir);
+
+        constexpr std::size_t files{500};
+        std::vector<fs::path> paths;
+        for (std::size_t file{}; file < files; ++file) {
+            auto& path{paths.emplace_back(dir / fmt::format("Preset {}.xml", file))};
+            std::ofstream out{path};
+            out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<SliderPresets>\n";
+            for (int preset{}; preset < 8; ++preset) {
+                out << fmt::format("<Preset name=\"File {} &amp; Preset {}\" set=\"CBBE Body\">\n", file, preset);
+                out << "<Group name=\"CBBE\"/>\n";
+                for (int slider{}; slider < 60; ++slider) {
+                    out << fmt::format("<SetSlider name=\"Slider{}\" size=\"big\" value=\"{}\"/>\n", slider, slider);
+                }
+                out << "</Preset>\n";
+            }
+            out << "</SliderPresets>\n";
+        }
+
+        const auto count{[](const pugi::xml_document& a_doc) {
+            std::size_t ret{};
+            for (const auto& preset : a_doc.child("SliderPresets")) {
+                for (const auto& slider : preset) ret += slider.attribute("value").as_int();
+            }
+            return ret;
+        }};
+
+        const auto regular{Measure(files, [&](const std::size_t i) {
+            pugi::xml_document doc;
+            doc.load_file(paths[i].c_str());
+            Consume(count(doc));
+        })};
+        const auto fast{Measure(files, [&](const std::size_t i) {
+            const auto size{static_cast<std::size_t>(fs::file_size(paths[i]))};
+            const auto buffer{std::make_unique_for_overwrite<char[]>(size)};
+            std::ifstream{paths[i], std::ios::binary}.read(buffer.get(), static_cast<std::streamsize>(size));
+
+            pugi::xml_document doc;
+            doc.load_buffer_inplace(buffer.get(), size, pugi::parse_minimal | pugi::parse_escapes,
+                                    pugi::encoding_auto);
+            Consume(count(doc));
+        })};
+
+        fs::remove_all(dir);
+        fmt::print("preset parse, {} files of 8 presets: load_file {:.0f} files/s, in place {:.0f} files/s\n", files,
+                   1e9 / regular, 1e9 / fast);
+    }
+#else
+    void BenchPresetParse() { fmt::print("preset parse: skipped, pugixml wasn't found when configuring\n"); }
+#endif
+
+    // ClassifyName against the three icontains loops it replaced
+    void BenchClassify() {
+        constexpr std::array clothed{"cloth"sv, "outfit"sv, "nevernude"sv, "bikini"sv, "feet"sv,
+                                     "hands"sv, "push"sv,   "cleavage"sv,  "armor"sv};
+        constexpr std::array male{"himbo"sv, "talos"sv, "sam"sv, "sos"sv, "savren"sv};
+        constexpr std::array unp{"unp"sv, "coco"sv, "bhunp"sv, "uunp"sv};
+        constexpr std::array fragments{"Curvy "sv, "BHUNP "sv, "Body"sv, " - "sv, "Outfit"sv, "x"sv, "3BA "sv,
+                                       "Slim"sv,   "Talos"sv,  "Zero"sv, "_"sv,   "Cloth"sv,  "Amazing "sv};
+
+        std::mt19937 gen{2024};
+        std::uniform_int_distribution<std::size_t> pick{0, fragments.size() - 1};
+        std::uniform_int_distribution<int> length{0, 6};
+        std::vector<std::string> names(200000);
+        for (auto& name : names) {
+            for (int parts{length(gen)}; parts > 0; --parts) name += fragments[pick(gen)];
+        }
+
+        std::size_t mismatches{};
+        const auto scanning{Measure(names.size(), [&](const std::size_t i) {
+            const auto traits{stl::contains(names[i], clothed) * 4 + stl::contains(names[i], male) * 2 +
+                              stl::contains(names[i], unp)};
+            Consume(traits);
+        })};
+        const auto automaton{Measure(names.size(), [&](const std::size_t i) {
+            const auto traits{PresetManager::ClassifyName(names[i])};
+            Consume(traits.clothed * 4 + traits.male * 2 + traits.unp);
+        })};
+        for (const auto& name : names) {
+            const auto traits{PresetManager::ClassifyName(name)};
+            mismatches += traits.clothed != stl::contains(name, clothed) || traits.male != stl::contains(name, male) ||
+                          traits.unp != stl::contains(name, unp);
+        }
+
+        fmt::print("classify, {} names: icontains loops {:.0f} ns/name, ClassifyName {:.0f} ns/name, {} mismatches\n",
+                   names.size(), scanning, automaton, mismatches);
+    }
+
+    // stl::id_set against the linear scans over the config arrays it replaced
+    void BenchIdSet() {
+        constexpr std::size_t lookups{20000};
+        for (const std::size_t entries : {10uz, 1000uz, 100000uz}) {
+            std::vector<std::uint32_t> list;
+            stl::id_set set;
+            for (std::uint32_t i{}; i < entries; ++i) {
+                list.push_back(0x01000800 + i * 2);
+                set.insert(list.back());
+            }
+
+            // Every other query is a hit
+            const auto query{[&](const std::size_t i) {
+                return static_cast<std::uint32_t>(0x01000800 + (i * 7919 % entries) * 2 + (i & 1));
+            }};
+            const auto scan{Measure(lookups, [&](const std::size_t i) {
+                Consume(std::ranges::find(list, query(i)) != list.end());
+            })};
+            const auto hashed{Measure(lookups, [&](const std::size_t i) { Consume(set.contains(query(i))); })};
+
+            fmt::print("id_set, {} entries: linear scan {:.0f} ns/lookup, id_set {:.0f} ns/lookup\n", entries, scan,
+                       hashed);
+        }
+    }
+
+    // stl::string_set against the linear finds over the config arrays it replaced
+    void BenchStringSet() {
+        constexpr std::size_t lookups{20000};
+        for (const std::size_t entries : {10uz, 5000uz, 50000uz}) {
+            std::vector<std::string> list;
+            for (std::size_t i{}; i < entries; ++i) list.push_back(fmt::format("Blacklisted Npc {:06}", i * 2));
+            const stl::string_set set{list};
+
+            std::vector<std::string> queries(lookups);
+            for (std::size_t i{}; i < lookups; ++i) {
+                queries[i] = fmt::format("Blacklisted Npc {:06}", (i * 7919 % entries) * 2 + (i & 1));
+            }
+
+            const auto scan{Measure(lookups, [&](const std::size_t i) {
+                Consume(std::ranges::find(list, queries[i]) != list.end());
+            })};
+            const auto hashed{Measure(lookups, [&](const std::size_t i) { Consume(set.contains(queries[i])); })};
+
+            fmt::print("string_set, {} names: linear find {:.0f} ns/lookup, string_set {:.0f} ns/lookup\n", entries,
+                       scan, hashed);
+        }
+    }
+
+    // stl::random against the random_device and mt19937 it used to build for every draw
+    void BenchRandom() {
+        const auto legacy{Measure(200000, [](std::size_t) {
+            std::random_device device;
+            std::mt19937 gen{device()};
+            std::uniform_real_distribution distribution{-0.3f, std::nextafter(0.8f, -0.3f)};
+            Consume(distribution(gen) > 0.0f);
+        })};
+        const auto floats{Measure(50000000, [](std::size_t) { Consume(stl::random(-0.3f, 0.8f) > 0.0f); })};
+        const auto ints{Measure(50000000, [](std::size_t) { Consume(stl::random(0ull, 37ull)); })};
+
+        fmt::print("random: per-call mt19937 {:.3g} floats/s, xoshiro256** {:.3g} floats/s and {:.3g} ints/s\n",
+                   1e9 / legacy, 1e9 / floats, 1e9 / ints);
+    }
+
+    // The compiled default tables against the hand-written chains they replaced
+    void BenchRandomSliders() {
+        const auto nipple{*PresetManager::RandomSliderTable::Compile(PresetManager::DefaultNippleSliders())};
+        const auto genital{*PresetManager::RandomSliderTable::Compile(PresetManager::DefaultGenitalSliders())};
+
+        constexpr std::size_t actors{1000000};
+        std::vector<PresetManager::RandomSliders> batch(100000);
+        const auto tables{Measure(actors / batch.size(), [&](std::size_t) {
+                              nipple.Generate(batch);
+                              genital.Generate(batch);
+                              Consume(batch.back().size());
+                          }) /
+                          static_cast<double>(batch.size())};
+        const auto chains{Measure(actors, [](std::size_t) {
+            Consume(Legacy::GenerateNippleSliders().size() + Legacy::GenerateGenitalSliders().size());
+        })};
+
+        fmt::print("random sliders: legacy chains {:.3g} actors/s, tables in batches {:.3g} actors/s\n", 1e9 / chains,
+                   1e9 / tables);
+    }
+}  // namespace
+
+int main(const int a_argc, const char* a_argv[]) {
+    const std::array<std::pair<std::string_view, void (*)()>, 9> benchmarks{{
+        {"parallel_for", BenchParallelFor},
+        {"preset_lookup", BenchPresetLookup},
+        {"preset_snapshot", BenchPresetSnapshot},
+        {"preset_parse", BenchPresetParse},
+        {"classify", BenchClassify},
+        {"id_set", BenchIdSet},
+        {"string_set", BenchStringSet},
+        {"random", BenchRandom},
+        {"random_sliders", BenchRandomSliders},
+    }};
+
+    const std::vector<std::string_view> selected(a_argv + 1, a_argv + a_argc);
+    for (const auto& [name, run] : benchmarks) {
+        if (selected.empty() || std::ranges::find(selected, name) != selected.end()) run();
+    }
+}
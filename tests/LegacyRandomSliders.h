@@ -0,0 +1,134 @@
+#pragma once
+
+#include "STLCore.h"
+
+// The hand-written random nipple and genital slider chains that PresetManager::RandomSliderTable replaced, kept as the
+// reference the default tables must reproduce draw for draw, and as the baseline of the random slider benchmark
+namespace Legacy {
+    using Sliders = std::vector<std::pair<std::string, float>>;
+
+    inline Sliders GenerateNippleSliders() {
+        Sliders set;
+
+        if (stl::chance(15))
+            set.emplace_back("AreolaSize", stl::random(-1.0f, 0.0f));
+        else
+            set.emplace_back("AreolaSize", stl::random(0.0f, 1.0f));
+
+        if (stl::chance(75)) set.emplace_back("AreolaPull_v2", stl::random(-0.25f, 1.0f));
+
+        if (stl::chance(15))
+            set.emplace_back("NippleLength", stl::random(0.2f, 0.3f));
+        else
+            set.emplace_back("NippleLength", stl::random(0.0f, 0.1f));
+
+        set.emplace_back("NippleManga", stl::random(-0.3f, 0.8f));
+
+        if (stl::chance(25)) set.emplace_back("NipplePerkManga", stl::random(-0.3f, 1.2f));
+
+        if (stl::chance(15)) set.emplace_back("NipBGone", stl::random(0.6f, 1.0f));
+
+        set.emplace_back("NippleSize", stl::random(-0.5f, 0.3f));
+        set.emplace_back("NippleDip", stl::random(0.0f, 1.0f));
+        set.emplace_back("NippleCrease_v2", stl::random(-0.4f, 1.0f));
+
+        if (stl::chance(6)) set.emplace_back("NipplePuffy_v2", stl::random(0.4f, 0.7f));
+
+        if (stl::chance(35)) set.emplace_back("NippleThicc_v2", stl::random(0.0f, 0.9f));
+
+        if (stl::chance(2)) {
+            if (stl::chance(50))
+                set.emplace_back("NippleInvert_v2", 1.0f);
+            else
+                set.emplace_back("NippleInvert_v2", stl::random(0.65f, 0.8f));
+        }
+
+        return set;
+    }
+
+    inline Sliders GenerateGenitalSliders() {
+        Sliders set;
+
+        if (stl::chance(20)) {
+            // innie
+            set.emplace_back("Innieoutie", stl::random(0.95f, 1.1f));
+
+            if (stl::chance(50)) set.emplace_back("Labiapuffyness", stl::random(0.75f, 1.25f));
+
+            if (stl::chance(40)) set.emplace_back("LabiaMorePuffyness_v2", stl::random(0.0f, 1.0f));
+
+            set.emplace_back("Labiaprotrude", stl::random(0.0f, 0.5f));
+            set.emplace_back("Labiaprotrude2", stl::random(0.0f, 0.1f));
+            set.emplace_back("Labiaprotrudeback", stl::random(0.0f, 0.1f));
+            set.emplace_back("Labiaspread", 0.0F);
+            set.emplace_back("LabiaCrumpled_v2", stl::random(0.0f, 0.3f));
+            set.emplace_back("LabiaBulgogi_v2", 0.0F);
+            set.emplace_back("LabiaNeat_v2", 0.0F);
+            set.emplace_back("VaginaHole", stl::random(-0.2f, 0.05f));
+            set.emplace_back("Clit", stl::random(-0.4f, 0.25f));
+        } else if (stl::chance(75)) {
+            // average
+            set.emplace_back("Innieoutie", stl::random(0.4f, 0.75f));
+
+            if (stl::chance(40)) set.emplace_back("Labiapuffyness", stl::random(0.5f, 1.0f));
+
+            if (stl::chance(30)) set.emplace_back("LabiaMorePuffyness_v2", stl::random(0.0f, 0.75f));
+
+            set.emplace_back("Labiaprotrude", stl::random(0.0f, 0.5f));
+            set.emplace_back("Labiaprotrude2", stl::random(0.0f, 0.75f));
+            set.emplace_back("Labiaprotrudeback", stl::random(0.0f, 1.0f));
+
+            if (stl::chance(50)) {
+                set.emplace_back("Labiaspread", stl::random(0.0f, 1.0f));
+                set.emplace_back("LabiaCrumpled_v2", stl::random(0.0f, 0.7f));
+
+                if (stl::chance(60)) set.emplace_back("LabiaBulgogi_v2", stl::random(0.0f, 0.1f));
+            } else {
+                set.emplace_back("Labiaspread", 0.0F);
+                set.emplace_back("LabiaCrumpled_v2", stl::random(0.0f, 0.2f));
+
+                if (stl::chance(45)) set.emplace_back("LabiaBulgogi_v2", stl::random(0.0f, 0.3f));
+            }
+
+            set.emplace_back("LabiaNeat_v2", 0.0F);
+            set.emplace_back("VaginaHole", stl::random(-0.2f, 0.40f));
+            set.emplace_back("Clit", stl::random(-0.2f, 0.25f));
+        } else {
+            // outie
+            set.emplace_back("Innieoutie", stl::random(-0.25f, 0.30f));
+
+            if (stl::chance(30)) set.emplace_back("Labiapuffyness", stl::random(0.20f, 0.50f));
+
+            if (stl::chance(10)) set.emplace_back("LabiaMorePuffyness_v2", stl::random(0.0f, 0.35f));
+
+            set.emplace_back("Labiaprotrude", stl::random(0.0f, 1.0f));
+            set.emplace_back("Labiaprotrude2", stl::random(0.0f, 1.0f));
+            set.emplace_back("Labiaprotrudeback", stl::random(0.0f, 1.0f));
+            set.emplace_back("Labiaspread", stl::random(0.0f, 1.0f));
+            set.emplace_back("LabiaCrumpled_v2", stl::random(0.0f, 1.0f));
+            set.emplace_back("LabiaBulgogi_v2", stl::random(0.0f, 1.0f));
+
+            if (stl::chance(40)) set.emplace_back("LabiaNeat_v2", stl::random(0.0f, 0.25f));
+
+            set.emplace_back("VaginaHole", stl::random(0.0f, 1.0f));
+            set.emplace_back("Clit", stl::random(-0.4f, 0.25f));
+        }
+
+        set.emplace_back("Vaginasize", stl::random(0.0f, 1.0f));
+        set.emplace_back("ClitSwell_v2", stl::random(-0.3f, 1.1f));
+        set.emplace_back("Cutepuffyness", stl::random(0.0f, 1.0f));
+        set.emplace_back("LabiaTightUp", stl::random(0.0f, 1.0f));
+
+        if (stl::chance(60))
+            set.emplace_back("CBPC", stl::random(-0.25f, 0.25f));
+        else
+            set.emplace_back("CBPC", stl::random(0.6f, 1.0f));
+
+        set.emplace_back("AnalPosition_v2", stl::random(0.0f, 1.0f));
+        set.emplace_back("AnalTexPos_v2", stl::random(0.0f, 1.0f));
+        set.emplace_back("AnalTexPosRe_v2", stl::random(0.0f, 1.0f));
+        set.emplace_back("AnalLoose_v2", -0.1F);
+
+        return set;
+    }
+}  // namespace Legacy
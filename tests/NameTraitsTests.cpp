@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "PresetManager/NameTraits.h"
+
+namespace {
+    using PresetManager::ClassifyName;
+    using PresetManager::NameTraits;
+
+    constexpr std::array ClothedKeywords{"cloth"sv, "outfit"sv, "nevernude"sv, "bikini"sv, "feet"sv,
+                                         "hands"sv, "push"sv,   "cleavage"sv,  "armor"sv};
+    constexpr std::array MaleKeywords{"himbo"sv, "talos"sv, "sam"sv, "sos"sv, "savren"sv};
+    constexpr std::array UNPKeywords{"unp"sv, "coco"sv, "bhunp"sv, "uunp"sv};
+
+    // The icontains loops ClassifyName replaced
+    NameTraits ClassifyNameByScanning(const std::string_view a_name) {
+        const auto any{[&](const auto& a_keywords) {
+            return std::ranges::any_of(a_keywords, [&](const auto a_keyword) {
+                return boost::algorithm::icontains(a_name, a_keyword);
+            });
+        }};
+        return {any(ClothedKeywords), any(MaleKeywords), any(UNPKeywords)};
+    }
+
+    void ExpectTraits(const NameTraits& a_traits, const bool a_clothed, const bool a_male, const bool a_unp) {
+        EXPECT_EQ(a_traits.clothed, a_clothed);
+        EXPECT_EQ(a_traits.male, a_male);
+        EXPECT_EQ(a_traits.unp, a_unp);
+    }
+
+    TEST(ClassifyName, FindsEveryKeywordGroup) {
+        ExpectTraits(ClassifyName("CBBE Curvy"), false, false, false);
+        ExpectTraits(ClassifyName("BHUNP Outfit"), true, false, true);
+        ExpectTraits(ClassifyName("HIMBO Simple"), false, true, false);
+        ExpectTraits(ClassifyName("Nevernude - CoCo Bikini"), true, false, true);
+        ExpectTraits(ClassifyName(L"SOS Savren Armor"), true, true, false);
+        ExpectTraits(ClassifyName(""), false, false, false);
+    }
+
+    TEST(ClassifyName, MatchesOverlappingKeywords) {
+        // "bhunp" and "uunp" both end in "unp", "sam" starts over inside "ssam"
+        ExpectTraits(ClassifyName("xbhunpx"), false, false, true);
+        ExpectTraits(ClassifyName("uuunp"), false, false, true);
+        ExpectTraits(ClassifyName("ssam"), false, true, false);
+        ExpectTraits(ClassifyName("clocloth"), true, false, false);
+    }
+
+    TEST(ClassifyName, DoesNotMatchAcrossOtherCharacters) {
+        ExpectTraits(ClassifyName("s-a-m u n p"), false, false, false);
+        ExpectTraits(ClassifyName("cl0th"), false, false, false);
+    }
+
+    TEST(ClassifyName, AgreesWithScanningOnRandomNames) {
+        // Fragments of keywords plus separators, so names often get close to a keyword without finishing it
+        constexpr std::array fragments{"cl"sv, "oth"sv, "out"sv, "fit"sv, "un"sv,  "p"sv,   "bh"sv, "uu"sv,  "co"sv,
+                                       "sa"sv, "m"sv,   "so"sv,  "s"sv,   "ven"sv, "ta"sv,  "los"sv, "HIM"sv, "bo"sv,
+                                       "Ar"sv, "mor"sv, "Push"sv, " "sv,   "_"sv,   "-"sv,  "7"sv,  "é"sv,   "x"sv};
+
+        std::mt19937 gen{2024};
+        std::uniform_int_distribution<std::size_t> pick{0, fragments.size() - 1};
+        std::uniform_int_distribution<int> length{0, 12};
+        std::bernoulli_distribution upper{0.3};
+
+        for (int i{}; i < 100000; ++i) {
+            std::string name;
+            for (int parts{length(gen)}; parts > 0; --parts) name += fragments[pick(gen)];
+            for (auto& c : name) {
+                if (c >= 'a' && c <= 'z' && upper(gen)) c = static_cast<char>(c - 'a' + 'A');
+            }
+
+            const auto expected{ClassifyNameByScanning(name)};
+            const auto actual{ClassifyName(name)};
+            ASSERT_EQ(actual.clothed, expected.clothed) << name;
+            ASSERT_EQ(actual.male, expected.male) << name;
+            ASSERT_EQ(actual.unp, expected.unp) << name;
+        }
+    }
+
+    TEST(IsClothedSet, TakesFileNames) {
+        EXPECT_TRUE(PresetManager::IsClothedSet(L"CBBE Outfits.xml"));
+        EXPECT_FALSE(PresetManager::IsClothedSet(L"CBBE Bodies.xml"));
+        EXPECT_TRUE(PresetManager::IsClothedSet("Zeroed Sliders - Nevernude"));
+    }
+}  // namespace
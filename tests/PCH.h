@@ -0,0 +1,44 @@
+#pragma once
+
+// Stand-in for src/PCH.h: the same standard library, Boost and logger, without CommonLibSSE, rapidjson and pugixml
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <shared_mutex>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <spdlog/spdlog.h>
+
+// PresetManager.h only declares functions that take a node
+namespace pugi {
+    class xml_node;
+}
+
+namespace logger = spdlog;
+namespace fs = std::filesystem;
+
+using namespace std::literals;
+
+#define sprintf_s snprintf
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "PresetManager/PresetManager.h"
+
+namespace {
+    using PresetManager::Preset;
+    using PresetManager::PresetSet;
+
+    // One parsed file, shared the way LoadPresets shares it between snapshots
+    std::shared_ptr<const std::vector<Preset>> MakeFile(const std::initializer_list<const char*> a_names) {
+        auto ret{std::make_shared<std::vector<Preset>>()};
+        for (const auto* const name : a_names) ret->emplace_back(name, "CBBE Body", PresetManager::SliderSet{});
+        return ret;
+    }
+
+    TEST(PresetSet, SharesPresetsInsteadOfCopying) {
+        const auto file{MakeFile({"Curvy", "Slim"})};
+
+        PresetSet set;
+        for (const auto& preset : *file) set.push_back({file, &preset});
+        const auto copy{set};
+
+        PresetSet all;
+        all.append(set);
+        all.append(copy);
+
+        ASSERT_EQ(all.size(), 4u);
+        EXPECT_EQ(&all[0], &(*file)[0]);
+        EXPECT_EQ(&all[3], &(*file)[1]);
+        EXPECT_EQ(copy.Find("Slim"), &(*file)[1]);
+        EXPECT_EQ(file.use_count(), 9);
+    }
+
+    TEST(PresetSet, FindsCaseInsensitivelyAndKeepsTheFirstName) {
+        const auto file{MakeFile({"Curvy", "CURVY", "Slim"})};
+
+        PresetSet set;
+        for (const auto& preset : *file) set.push_back({file, &preset});
+
+        EXPECT_EQ(set.IndexOf("curvy"), 0u);
+        EXPECT_EQ(set.Find("sLiM"), &(*file)[2]);
+        EXPECT_EQ(set.Find("Athletic"), nullptr);
+        EXPECT_FALSE(set.IndexOf("Athletic"));
+    }
+
+    TEST(PresetSet, OutlivesTheLoadThatBuiltIt) {
+        PresetSet set;
+        {
+            const auto file{MakeFile({"Curvy"})};
+            set.push_back({file, &file->front()});
+        }
+
+        ASSERT_NE(set.Find("Curvy"), nullptr);
+        EXPECT_EQ(set.Find("Curvy")->body, "CBBE Body");
+
+        // Iterating yields the presets themselves, the way GetAllPossiblePresets reads their names
+        const auto names{set | std::views::transform(&Preset::name)};
+        EXPECT_EQ(std::vector(names.begin(), names.end()), std::vector<std::string>{"Curvy"});
+    }
+}  // namespace
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "LegacyRandomSliders.h"
+#include "PresetManager/RandomSliders.h"
+
+namespace {
+    using PresetManager::RandomSliders;
+    using PresetManager::RandomSliderTable;
+    using Token = PresetManager::RandomSliderToken;
+    using Type = Token::Type;
+
+    Legacy::Sliders ToLegacy(const RandomSliders& a_sliders) {
+        auto& names{PresetManager::SliderNames::GetInstance()};
+
+        Legacy::Sliders ret;
+        for (std::size_t i{}; i < a_sliders.size(); ++i) {
+            ret.emplace_back(names.GetName(a_sliders.ids[i]), a_sliders.values[i]);
+        }
+        return ret;
+    }
+
+    TEST(RandomSliderTable, DefaultsReproduceTheLegacyChains) {
+        const auto nipple{RandomSliderTable::Compile(PresetManager::DefaultNippleSliders())};
+        const auto genital{RandomSliderTable::Compile(PresetManager::DefaultGenitalSliders())};
+        ASSERT_TRUE(nipple && genital);
+
+        RandomSliders sliders;
+        for (std::uint64_t seed{}; seed < 200000; ++seed) {
+            Legacy::Sliders expectedNipple, expectedGenital;
+            {
+                const stl::deterministic_random random{seed};
+                expectedNipple = Legacy::GenerateNippleSliders();
+                expectedGenital = Legacy::GenerateGenitalSliders();
+            }
+
+            const stl::deterministic_random random{seed};
+            nipple->Generate(sliders);
+            ASSERT_EQ(ToLegacy(sliders), expectedNipple) << "seed " << seed;
+            genital->Generate(sliders);
+            ASSERT_EQ(ToLegacy(sliders), expectedGenital) << "seed " << seed;
+        }
+    }
+
+    TEST(RandomSliderTable, BatchMatchesSingleRuns) {
+        const auto table{RandomSliderTable::Compile(PresetManager::DefaultGenitalSliders())};
+        ASSERT_TRUE(table);
+
+        std::vector<RandomSliders> batch(64);
+        {
+            const stl::deterministic_random random{99};
+            table->Generate(batch);
+        }
+
+        const stl::deterministic_random random{99};
+        RandomSliders single;
+        for (const auto& sliders : batch) {
+            table->Generate(single);
+            EXPECT_EQ(ToLegacy(single), ToLegacy(sliders));
+        }
+    }
+
+    TEST(RandomSliderTable, FixedValuesDontDraw) {
+        const std::array tokens{Token{Type::kSlider, 100, "NippleInvert_v2", 1.0f, 1.0f}};
+        const auto table{RandomSliderTable::Compile(tokens)};
+        ASSERT_TRUE(table);
+
+        const auto before{stl::rng()};
+        RandomSliders sliders;
+        table->Generate(sliders);
+
+        ASSERT_EQ(sliders.size(), 1u);
+        EXPECT_EQ(sliders.values[0], 1.0f);
+        auto expected{before};
+        EXPECT_EQ(stl::rng()(), expected());
+    }
+
+    TEST(RandomSliderTable, RejectsMalformedTokens) {
+        const std::array unclosed{Token{Type::kOneOf}, Token{Type::kOption, 50}, Token{Type::kSlider, 100, "X", 0, 1}};
+        EXPECT_FALSE(RandomSliderTable::Compile(unclosed));
+
+        const std::array stray{Token{Type::kEnd}};
+        EXPECT_FALSE(RandomSliderTable::Compile(stray));
+
+        const std::array badChance{Token{Type::kSlider, 101, "X", 0, 1}};
+        EXPECT_FALSE(RandomSliderTable::Compile(badChance));
+
+        const std::array negativeChance{Token{Type::kSlider, -1, "X", 0, 1}};
+        EXPECT_FALSE(RandomSliderTable::Compile(negativeChance));
+
+        const std::array inverted{Token{Type::kSlider, 100, "X", 1, 0}};
+        EXPECT_FALSE(RandomSliderTable::Compile(inverted));
+
+        const std::array unnamed{Token{Type::kSlider, 100, "", 0, 1}};
+        EXPECT_FALSE(RandomSliderTable::Compile(unnamed));
+    }
+
+    TEST(RandomSliderTable, RejectsMoreSlidersThanOneRunHolds) {
+        std::vector<Token> tokens(RandomSliders::Capacity, Token{Type::kSlider, 100, "X", 0, 1});
+        EXPECT_TRUE(RandomSliderTable::Compile(tokens));
+
+        tokens.push_back(tokens.back());
+        EXPECT_FALSE(RandomSliderTable::Compile(tokens));
+    }
+
+    TEST(RandomSliderTable, CountsOnlyTheLargestOption) {
+        // Either option alone fits, so the choice as a whole does too
+        std::vector<Token> tokens{Token{Type::kOneOf}, Token{Type::kOption, 50}};
+        tokens.insert(tokens.end(), RandomSliders::Capacity, Token{Type::kSlider, 100, "X", 0, 1});
+        tokens.push_back(Token{Type::kOption});
+        tokens.insert(tokens.end(), RandomSliders::Capacity, Token{Type::kSlider, 100, "Y", 0, 1});
+        tokens.push_back(Token{Type::kEnd});
+
+        EXPECT_TRUE(RandomSliderTable::Compile(tokens));
+    }
+}  // namespace
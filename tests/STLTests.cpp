@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "STLCore.h"
+
+namespace {
+    TEST(ParallelFor, VisitsEveryIndexOnce) {
+        constexpr std::size_t count{10000};
+        std::vector<std::atomic_int> visits(count);
+
+        stl::parallel_for(count, [&](const std::size_t i) { visits[i].fetch_add(1); }, 8);
+
+        for (std::size_t i{}; i < count; ++i) EXPECT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+
+    TEST(ParallelFor, HandlesFewerItemsThanThreads) {
+        std::atomic_int calls{};
+        stl::parallel_for(0, [&](std::size_t) { ++calls; }, 4);
+        stl::parallel_for(3, [&](std::size_t) { ++calls; }, 64);
+
+        EXPECT_EQ(calls.load(), 3);
+    }
+
+    TEST(ParallelFor, RethrowsOnTheCallingThread) {
+        std::atomic_int calls{};
+        const auto run{[&] {
+            stl::parallel_for(
+                1000,
+                [&](const std::size_t i) {
+                    ++calls;
+                    if (i == 10) throw std::runtime_error("file 10 failed");
+                },
+                4);
+        }};
+
+        EXPECT_THROW(run(), std::runtime_error);
+        EXPECT_LT(calls.load(), 1000);
+    }
+
+    TEST(IdMap, FirstInsertWins) {
+        stl::id_map<int> map;
+        EXPECT_TRUE(map.emplace(0x14, 1));
+        EXPECT_FALSE(map.emplace(0x14, 2));
+        EXPECT_FALSE(map.emplace(0, 3));
+
+        ASSERT_NE(map.find(0x14), nullptr);
+        EXPECT_EQ(*map.find(0x14), 1);
+        EXPECT_EQ(map.find(0x15), nullptr);
+        EXPECT_EQ(map.find(0), nullptr);
+        EXPECT_EQ(map.size(), 1u);
+    }
+
+    TEST(IdSet, MatchesUnorderedSet) {
+        std::mt19937 gen{7};
+        std::uniform_int_distribution<std::uint32_t> formID{0, 0x20000};
+
+        stl::id_set set;
+        std::unordered_set<std::uint32_t> expected;
+        for (int i{}; i < 50000; ++i) {
+            const auto id{formID(gen)};
+            EXPECT_EQ(set.insert(id), id != 0 && expected.insert(id).second);
+        }
+
+        EXPECT_EQ(set.size(), expected.size());
+        for (std::uint32_t id{}; id <= 0x20000; ++id) ASSERT_EQ(set.contains(id), expected.contains(id)) << id;
+    }
+
+    TEST(StringSet, IsExactAndCaseSensitive) {
+        const stl::string_set set{{"Bandit", "Nazeem", "Nazeem", ""}};
+
+        EXPECT_EQ(set.size(), 4u);
+        EXPECT_TRUE(set.contains("Bandit"));
+        EXPECT_TRUE(set.contains("Nazeem"));
+        EXPECT_TRUE(set.contains(""));
+        EXPECT_FALSE(set.contains("bandit"));
+        EXPECT_FALSE(set.contains("Bandit "));
+        EXPECT_FALSE(stl::string_set{}.contains(""));
+    }
+
+    TEST(StringSet, MatchesUnorderedSet) {
+        std::vector<std::string> names;
+        for (int i{}; i < 5000; ++i) names.push_back(fmt::format("Npc{:05}", i * 3));
+        const std::unordered_set<std::string> expected{names.begin(), names.end()};
+        const stl::string_set set{names};
+
+        for (int i{}; i < 15000; ++i) {
+            const auto name{fmt::format("Npc{:05}", i)};
+            ASSERT_EQ(set.contains(name), expected.contains(name)) << name;
+        }
+    }
+
+    TEST(StringSet, ViewsMatchOwnedStrings) {
+        const std::array<std::string, 3> forms{"Skyrim.esm", "Dawnguard.esm", "Dragonborn.esm"};
+        const stl::string_view_set set{{forms.begin(), forms.end()}};
+
+        EXPECT_TRUE(set.contains("Dawnguard.esm"));
+        EXPECT_FALSE(set.contains("Update.esm"));
+    }
+
+    TEST(AliasTable, SamplesInProportionToTheWeights) {
+        const std::array weights{1.0f, 0.0f, 3.0f, -2.0f, 4.0f};
+        const stl::alias_table table{weights};
+        ASSERT_EQ(table.size(), weights.size());
+
+        constexpr int draws{800000};
+        std::array<int, weights.size()> hits{};
+        const stl::deterministic_random seed{1};
+        for (int i{}; i < draws; ++i) {
+            ++hits[table.sample(stl::random<std::size_t>(0, table.size()), stl::random(0.0f, 1.0f))];
+        }
+
+        EXPECT_EQ(hits[1], 0);
+        EXPECT_EQ(hits[3], 0);
+        EXPECT_NEAR(hits[0] / double{draws}, 1.0 / 8, 0.005);
+        EXPECT_NEAR(hits[2] / double{draws}, 3.0 / 8, 0.005);
+        EXPECT_NEAR(hits[4] / double{draws}, 4.0 / 8, 0.005);
+    }
+
+    TEST(AliasTable, StaysEmptyWithoutPositiveWeights) {
+        constexpr std::array weights{0.0f, -1.0f};
+        EXPECT_TRUE(stl::alias_table{weights}.empty());
+        EXPECT_TRUE(stl::alias_table{}.empty());
+    }
+
+    TEST(Xoshiro256ss, MatchesTheReferenceSequence) {
+        // The first outputs of the reference implementation after seeding through splitmix64 from 0
+        stl::xoshiro256ss engine{0};
+        const std::array<std::uint64_t, 3> expected{0x99EC5F36CB75F2B4ull, 0xBF6E1F784956452Aull,
+                                                    0x1A5F849D4933E6E0ull};
+        for (const auto value : expected) EXPECT_EQ(engine(), value);
+    }
+
+    TEST(Random, StaysInTheHalfOpenRange) {
+        for (int i{}; i < 200000; ++i) {
+            const auto value{stl::random(-0.3f, 0.8f)};
+            ASSERT_GE(value, -0.3f);
+            ASSERT_LT(value, 0.8f);
+
+            const auto index{stl::random(-5, 5)};
+            ASSERT_GE(index, -5);
+            ASSERT_LT(index, 5);
+        }
+
+        EXPECT_THROW(stl::random(1.0f, 1.0f), std::invalid_argument);
+        EXPECT_THROW(stl::random(3, 2), std::invalid_argument);
+    }
+
+    TEST(Random, ChanceHonoursItsBounds) {
+        for (int i{}; i < 10000; ++i) {
+            ASSERT_TRUE(stl::chance(100));
+            ASSERT_FALSE(stl::chance(-1));
+        }
+    }
+
+    TEST(DeterministicRandom, ReplaysAndRestoresTheSequence) {
+        const auto draw{[] {
+            std::array<float, 8> ret{};
+            for (auto& value : ret) value = stl::random(0.0f, 1.0f);
+            return ret;
+        }};
+
+        const auto before{stl::rng()};
+        std::array<float, 8> first{}, second{};
+        {
+            const stl::deterministic_random seed{0x0001A2B3ull << 32};
+            first = draw();
+        }
+        {
+            const stl::deterministic_random seed{0x0001A2B3ull << 32};
+            second = draw();
+        }
+
+        EXPECT_EQ(first, second);
+
+        auto expected{before};
+        EXPECT_EQ(stl::rng()(), expected());
+    }
+}  // namespace